@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <hilbert_codec.hpp>
+#include <hilbert_iterator.hpp>
+#include <matrix.hpp>
+#include <morton_codec.hpp>
+#include <morton_iterator.hpp>
+
+#include "suite.hpp"
+
+// Matrix traversal (sum of the cells) in row major, Morton and Hilbert order,
+// and curve index encode / decode batches. Size is the matrix side (a power of
+// two for the traversals) or the number of keys.
+
+namespace bench {
+namespace {
+constexpr unsigned kOrder = 16; // order of the encoded keys
+
+std::vector<std::size_t>
+sides() {
+	return {256, 1024, 4096};
+}
+
+std::vector<std::size_t>
+keyCounts() {
+	return {1 << 10, 1 << 16, 1 << 20};
+}
+
+template <template <typename...> class Iterator>
+std::function<std::uint64_t()>
+traversal(std::size_t n) {
+	auto mat = std::make_shared<Matrix<int>>(n, 1);
+	return [mat]() {
+		long sum = 0;
+		Iterator<int> curve(*mat);
+		for (auto it = curve.begin(), last = curve.end(); it != last; ++it)
+			sum += *it;
+		keep(sum);
+		return std::uint64_t(mat->size());
+	};
+}
+
+template <template <typename...> class Iterator>
+Case
+traversalCase(const char* name) {
+	return {name, sides(), &traversal<Iterator>};
+}
+
+//! @struct Keys Random cells and their curve indices.
+struct Keys {
+	std::vector<std::uint32_t> xs, ys;
+	std::vector<std::uint64_t> ds;
+
+	explicit Keys(std::size_t count) : xs(count), ys(count), ds(count) {
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<std::uint32_t> coord(0, (1u << kOrder) - 1);
+		for (std::size_t i = 0; i < count; ++i)
+			xs[i] = coord(gen), ys[i] = coord(gen);
+	}
+};
+
+template <typename Encode>
+Case
+encodeCase(const char* name, Encode encode) {
+	return {name, keyCounts(), [encode](std::size_t count) {
+		        auto keys = std::make_shared<Keys>(count);
+		        return std::function<std::uint64_t()>([keys, encode]() {
+			        encode(keys->xs.data(), keys->ys.data(), keys->ds.data(),
+			               keys->ds.size(), kOrder);
+			        keep(keys->ds.back());
+			        return std::uint64_t(keys->ds.size());
+		        });
+	        }};
+}
+
+template <typename Encode, typename Decode>
+Case
+decodeCase(const char* name, Encode encode, Decode decode) {
+	return {name, keyCounts(), [encode, decode](std::size_t count) {
+		        auto keys = std::make_shared<Keys>(count);
+		        encode(keys->xs.data(), keys->ys.data(), keys->ds.data(), count, kOrder);
+		        return std::function<std::uint64_t()>([keys, decode]() {
+			        decode(keys->ds.data(), keys->xs.data(), keys->ys.data(),
+			               keys->ds.size(), kOrder);
+			        keep(keys->xs.back());
+			        return std::uint64_t(keys->ds.size());
+		        });
+	        }};
+}
+} // namespace
+
+void
+addCurveCases(std::vector<Case>& cases) {
+	cases.push_back({"curve/traversal/row_major", sides(), [](std::size_t n) {
+		                 auto mat = std::make_shared<Matrix<int>>(n, 1);
+		                 return std::function<std::uint64_t()>([mat]() {
+			                 long sum = 0;
+			                 for (int v : *mat)
+				                 sum += v;
+			                 keep(sum);
+			                 return std::uint64_t(mat->size());
+		                 });
+	                 }});
+	cases.push_back(traversalCase<morton::iterator>("curve/traversal/morton"));
+	cases.push_back(traversalCase<hilbert::iterator>("curve/traversal/hilbert"));
+
+	using EncodeBatch = void (*)(const std::uint32_t*, const std::uint32_t*,
+	                             std::uint64_t*, std::size_t, unsigned);
+	using DecodeBatch = void (*)(const std::uint64_t*, std::uint32_t*,
+	                             std::uint32_t*, std::size_t, unsigned);
+	cases.push_back(
+	  encodeCase("curve/encode/hilbert", EncodeBatch(&hilbert::encodeBatch)));
+	cases.push_back(encodeCase("curve/encode/morton", EncodeBatch(&morton::encodeBatch)));
+	cases.push_back(decodeCase("curve/decode/hilbert",
+	                           EncodeBatch(&hilbert::encodeBatch),
+	                           DecodeBatch(&hilbert::decodeBatch)));
+	cases.push_back(decodeCase("curve/decode/morton",
+	                           EncodeBatch(&morton::encodeBatch),
+	                           DecodeBatch(&morton::decodeBatch)));
+}
+} // namespace bench
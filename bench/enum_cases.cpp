@@ -0,0 +1,92 @@
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "enum_reflection.hpp"
+#include "suite.hpp"
+
+// X-macro enum reflection: printing size values with to_string, and parsing
+// size names (a quarter of them unknown) with the perfect hash from_string
+// against a linear search of the names. Items are the values or names.
+
+#define COLOR_LIST                                                               \
+	X(BLACK), X(WHITE), X(RED), X(GREEN), X(BLUE), X(CYAN), X(MAGENTA), X(YELLOW), \
+	  X(ORANGE), X(PURPLE), X(BROWN), X(GREY), X(PINK), X(OLIVE), X(NAVY), X(TEAL)
+
+enum class Color {
+#define X(name) name //!< @brief XMacro stuff.
+	COLOR_LIST
+#undef X
+};
+
+#define X(name) #name //!< @brief XMacro stuff.
+ENUM_NAMES(Color, COLOR_LIST);
+#undef X
+
+namespace bench {
+namespace {
+constexpr std::size_t kColors = std::size(EnumNames<Color>::values);
+
+std::vector<std::size_t>
+counts() {
+	return {1 << 10, 1 << 14, 1 << 18};
+}
+
+//! @brief Baseline of from_string: compare s to each name.
+std::optional<Color>
+linearFromString(std::string_view s) {
+	for (std::size_t i = 0; i < kColors; ++i) {
+		if (EnumNames<Color>::values[i] == s) return static_cast<Color>(i);
+	}
+	return std::nullopt;
+}
+
+std::shared_ptr<std::vector<std::string>>
+makeNames(std::size_t count) {
+	auto names = std::make_shared<std::vector<std::string>>(count);
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<std::size_t> value(0, kColors - 1);
+	for (std::size_t i = 0; i < count; ++i) {
+		(*names)[i] = EnumNames<Color>::values[value(gen)];
+		if (i % 4 == 3) (*names)[i] += '_'; // unknown
+	}
+	return names;
+}
+
+template <typename Parse>
+Case
+parseCase(const char* name, Parse parse) {
+	return {name, counts(), [parse](std::size_t count) {
+		        auto names = makeNames(count);
+		        return std::function<std::uint64_t()>([names, parse]() {
+			        std::size_t found = 0;
+			        for (const auto& s : *names)
+				        found += parse(s).has_value();
+			        keep(found);
+			        return std::uint64_t(names->size());
+		        });
+	        }};
+}
+} // namespace
+
+void
+addEnumCases(std::vector<Case>& cases) {
+	cases.push_back({"xmacro/to_string", counts(), [](std::size_t count) {
+		                 return std::function<std::uint64_t()>([count]() {
+			                 std::ostringstream out;
+			                 for (std::size_t i = 0; i < count; ++i)
+				                 out << to_string(static_cast<Color>(i % kColors)) << '\n';
+			                 keep(out.tellp());
+			                 return std::uint64_t(count);
+		                 });
+	                 }});
+	cases.push_back(parseCase("xmacro/from_string/linear", &linearFromString));
+	cases.push_back(parseCase("xmacro/from_string/perfect_hash",
+	                          [](std::string_view s) { return from_string<Color>(s); }));
+}
+} // namespace bench
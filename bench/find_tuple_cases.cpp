@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <find_tuple.hpp>
+#include <tuple_finder.hpp>
+
+#include "suite.hpp"
+
+// Repeated queries of 8 random values (half of them with a missing value) on
+// size inputs: find_tuple on a std::list and a std::vector against
+// tuple_finder (index of the list built once). Items are the queries.
+
+namespace bench {
+namespace {
+constexpr std::size_t kQueries = 64, kTupleSize = 8;
+
+//! @struct Queries Random inputs and value tuples.
+struct Queries {
+	std::list<int> list;
+	std::vector<int> vector;
+	std::vector<std::vector<int>> tuples;
+
+	explicit Queries(std::size_t count) : tuples(kQueries, std::vector<int>(kTupleSize)) {
+		const int max = static_cast<int>(count / 4 + 1);
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<int> value(0, max);
+		for (std::size_t i = 0; i < count; ++i)
+			list.push_back(value(gen));
+		vector.assign(list.begin(), list.end());
+		for (std::size_t i = 0; i < tuples.size(); ++i) {
+			for (auto& v : tuples[i])
+				v = value(gen);
+			if (i % 2) tuples[i].back() = max + 1; // missing
+		}
+	}
+};
+
+template <typename F>
+Case
+queryCase(const char* name, F query) {
+	return {name, {1 << 10, 1 << 14, 1 << 18}, [query](std::size_t count) {
+		        auto q = std::make_shared<Queries>(count);
+		        return std::function<std::uint64_t()>([q, query]() {
+			        std::size_t found = 0;
+			        for (const auto& t : q->tuples)
+				        found += query(*q, t);
+			        keep(found);
+			        return std::uint64_t(q->tuples.size());
+		        });
+	        }};
+}
+} // namespace
+
+void
+addFindTupleCases(std::vector<Case>& cases) {
+	cases.push_back(
+	  queryCase("find_tuple/list", [](Queries& q, const std::vector<int>& t) {
+		  return find_tuple(q.list.begin(), q.list.end(), t.begin(), t.end()).size();
+	  }));
+	cases.push_back(
+	  queryCase("find_tuple/vector", [](Queries& q, const std::vector<int>& t) {
+		  return find_tuple(q.vector.begin(), q.vector.end(), t.begin(), t.end()).size();
+	  }));
+
+	using ListIt = std::list<int>::iterator;
+	cases.push_back({"find_tuple/tuple_finder",
+	                 {1 << 10, 1 << 14, 1 << 18},
+	                 [](std::size_t count) {
+		                 auto q      = std::make_shared<Queries>(count);
+		                 auto finder = std::make_shared<tuple_finder<ListIt>>(
+		                   q->list.begin(), q->list.end());
+		                 return std::function<std::uint64_t()>([q, finder]() {
+			                 std::vector<ListIt> out(kTupleSize);
+			                 std::size_t found = 0;
+			                 for (const auto& t : q->tuples)
+				                 found += finder->find(t.begin(), t.end(), out.begin());
+			                 keep(found);
+			                 return std::uint64_t(q->tuples.size());
+		                 });
+	                 }});
+}
+} // namespace bench
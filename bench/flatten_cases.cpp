@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "flatten.hpp"
+#include "suite.hpp"
+
+// Flatten and filter size rows of 0 to 2 values (and a long row every 7 rows):
+// std::copy_if / vector insert loops against flatten and copy_if_compact.
+// Items are the rows.
+
+namespace bench {
+namespace {
+using Rows = std::vector<std::vector<int>>;
+
+std::shared_ptr<Rows>
+makeRows(std::size_t count) {
+	auto rows = std::make_shared<Rows>(count);
+	for (std::size_t i = 0; i < count; ++i)
+		(*rows)[i].assign(i % 7 == 0 ? 64 : i % 3, static_cast<int>(i));
+	return rows;
+}
+
+bool
+odd(const std::vector<int>& row) {
+	return !row.empty() && row[0] % 2;
+}
+
+template <typename F>
+Case
+rowsCase(const char* name, F func) {
+	return {name, {1 << 12, 1 << 16, 1 << 20}, [func](std::size_t count) {
+		        auto rows = makeRows(count);
+		        return std::function<std::uint64_t()>([rows, func]() {
+			        func(*rows);
+			        return std::uint64_t(rows->size());
+		        });
+	        }};
+}
+} // namespace
+
+void
+addFlattenCases(std::vector<Case>& cases) {
+	cases.push_back(rowsCase("flatten/insert", [](const Rows& rows) {
+		std::vector<int> out;
+		for (const auto& row : rows)
+			out.insert(out.end(), row.begin(), row.end());
+		keep(out.data());
+	}));
+	cases.push_back(rowsCase("flatten/flatten", [](const Rows& rows) {
+		std::vector<int> out(flatten_size(rows.begin(), rows.end()));
+		flatten(rows.begin(), rows.end(), out.begin());
+		keep(out.data());
+	}));
+	cases.push_back(rowsCase("flatten/copy_if", [](const Rows& rows) {
+		Rows out;
+		std::copy_if(rows.begin(), rows.end(), std::back_inserter(out), odd);
+		keep(out.data());
+	}));
+	cases.push_back(rowsCase("flatten/copy_if_compact", [](const Rows& rows) {
+		auto out = copy_if_compact(rows.begin(), rows.end(), odd);
+		keep(out.flatten().data());
+	}));
+}
+} // namespace bench
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <chrono>
+
+namespace bench {
+
+//! @brief Wall time of func() in nanoseconds (steady clock), shared by the
+//! standalone benchmarks of the snippets.
+template <typename F>
+double
+measure(F&& func) {
+	auto start = std::chrono::steady_clock::now();
+	func();
+	std::chrono::duration<double, std::nano> elapsed =
+	  std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+} // namespace bench
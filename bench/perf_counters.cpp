@@ -0,0 +1,94 @@
+#include "perf_counters.hpp"
+
+#ifdef __linux__
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+#ifdef __linux__
+namespace {
+int
+open(std::uint64_t config, int group) {
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.type           = PERF_TYPE_HARDWARE;
+	attr.size           = sizeof(attr);
+	attr.config         = config;
+	attr.disabled       = group < 0 ? 1 : 0; // the group leader starts them all
+	attr.exclude_kernel = 1;
+	attr.exclude_hv     = 1;
+	attr.read_format    = PERF_FORMAT_GROUP;
+	return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+} // namespace
+
+PerfCounters::PerfCounters() {
+	const std::uint64_t configs[kCount] = {
+	  PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+	for (int i = 0; i < kCount; ++i)
+		_fds[i] = -1;
+	for (int i = 0; i < kCount; ++i) {
+		_fds[i] = open(configs[i], i == 0 ? -1 : _fds[0]);
+		if (_fds[i] < 0) break;
+	}
+}
+
+PerfCounters::~PerfCounters() {
+	for (int i = kCount; i-- > 0;) {
+		if (_fds[i] >= 0) ::close(_fds[i]);
+	}
+}
+
+bool
+PerfCounters::available() const {
+	return _fds[kCount - 1] >= 0;
+}
+
+void
+PerfCounters::start() {
+	if (!available()) return;
+	::ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	::ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::Values
+PerfCounters::stop() {
+	Values res{0, 0, 0};
+	if (!available()) return res;
+	::ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	std::uint64_t data[1 + kCount] = {}; // count then the values
+	if (::read(_fds[0], data, sizeof(data)) == sizeof(data)) {
+		res.cycles       = data[1];
+		res.instructions = data[2];
+		res.cacheMisses  = data[3];
+	}
+	return res;
+}
+#else
+PerfCounters::PerfCounters() {
+	for (int i = 0; i < kCount; ++i)
+		_fds[i] = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+bool
+PerfCounters::available() const {
+	return false;
+}
+
+void
+PerfCounters::start() {}
+
+PerfCounters::Values
+PerfCounters::stop() {
+	return Values{0, 0, 0};
+}
+#endif
+} // namespace bench
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace bench {
+
+//! @class PerfCounters Hardware counters of the calling thread (cycles,
+//! instructions, cache misses) read through Linux perf_event_open, user space
+//! only. available() is false if the kernel (perf_event_paranoid), the
+//! container or the CPU do not allow them.
+class PerfCounters {
+	public:
+	struct Values {
+		std::uint64_t cycles;
+		std::uint64_t instructions;
+		std::uint64_t cacheMisses;
+	};
+
+	PerfCounters();
+	~PerfCounters();
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	bool available() const;
+	void start();
+	//! @brief Counts since start() (zero if not available).
+	Values stop();
+
+	private:
+	static constexpr int kCount = 3;
+	int _fds[kCount];
+};
+} // namespace bench
@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "intrusive_ptr.hpp"
+#include "transitive_ptr.hpp"
+#include "suite.hpp"
+
+// Smart pointer churn: allocate size objects, copy each owner once (shared
+// owners only), then destroy them all. std::shared_ptr against intrusive_ptr
+// (atomic and plain counts), and transitive_ptr (new / delete) against
+// pooled_ptr. Items are the objects.
+
+namespace bench {
+namespace {
+struct Shared {
+	int value = 0;
+};
+
+template <typename Count>
+struct Intrusive : RefCounted<Count> {
+	int value = 0;
+};
+
+std::vector<std::size_t>
+counts() {
+	return {1 << 10, 1 << 14, 1 << 18};
+}
+
+//! @brief Case making size owners with make(), a copy of each, then dropping
+//! them.
+template <typename Make>
+Case
+churnCase(const char* name, Make make) {
+	return {name, counts(), [make](std::size_t count) {
+		        return std::function<std::uint64_t()>([count, make]() {
+			        using Ptr = decltype(make());
+			        std::vector<Ptr> owners, copies;
+			        owners.reserve(count);
+			        copies.reserve(count);
+			        for (std::size_t i = 0; i < count; ++i)
+				        owners.push_back(make());
+			        for (const auto& p : owners)
+				        copies.push_back(p);
+			        keep(copies.back()->value);
+			        return std::uint64_t(count);
+		        });
+	        }};
+}
+
+//! @brief Same as churnCase for unique owners (no copy).
+template <typename Make>
+Case
+uniqueCase(const char* name, Make make) {
+	return {name, counts(), [make](std::size_t count) {
+		        return std::function<std::uint64_t()>([count, make]() {
+			        using Ptr = decltype(make());
+			        std::vector<Ptr> owners;
+			        owners.reserve(count);
+			        for (std::size_t i = 0; i < count; ++i)
+				        owners.push_back(make());
+			        keep(owners.back()->value);
+			        return std::uint64_t(count);
+		        });
+	        }};
+}
+} // namespace
+
+void
+addPointerCases(std::vector<Case>& cases) {
+	cases.push_back(
+	  churnCase("pointer/shared_ptr", []() { return std::make_shared<Shared>(); }));
+	cases.push_back(churnCase("pointer/intrusive_ptr/atomic", []() {
+		return make_intrusive<Intrusive<AtomicCount>>();
+	}));
+	cases.push_back(churnCase("pointer/intrusive_ptr/plain", []() {
+		return make_intrusive<Intrusive<PlainCount>>();
+	}));
+	cases.push_back(uniqueCase("pointer/transitive_ptr", []() {
+		return snippets::transitive_ptr<Shared>(new Shared());
+	}));
+	cases.push_back(
+	  uniqueCase("pointer/pooled_ptr", []() { return snippets::make_pooled<Shared>(); }));
+}
+} // namespace bench
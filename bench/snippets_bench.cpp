@@ -0,0 +1,96 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "suite.hpp"
+
+// Benchmark suite of the snippets (Matrix / curve traversal, encode / decode,
+// find_tuple, flatten / copy_if, X-macro enum printing and smart pointer
+// churn). Each case runs over a sweep of input sizes, the best of the repeated
+// runs is reported (progress on stderr, JSON results on request).
+// usage: snippets_bench [--list] [--filter substring] [--sizes n,n,...]
+//                       [--repeat n] [--counters] [--json file|-]
+
+namespace {
+std::vector<std::size_t>
+parseSizes(const std::string& list) {
+	std::vector<std::size_t> res;
+	std::istringstream in(list);
+	for (std::string item; std::getline(in, item, ',');) {
+		std::size_t end = 0;
+		const auto size = std::stoull(item, &end);
+		if (end != item.size() || size == 0)
+			throw std::runtime_error("invalid size: " + item);
+		res.push_back(size);
+	}
+	return res;
+}
+
+bench::Options
+parseOptions(int argc, char* argv[]) {
+	bench::Options res;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		auto value = [&]() -> std::string {
+			if (++i == argc) throw std::runtime_error("missing value of " + arg);
+			return argv[i];
+		};
+		if (arg == "--list") {
+			res.list = true;
+		} else if (arg == "--filter") {
+			res.filter = value();
+		} else if (arg == "--sizes") {
+			res.sizes = parseSizes(value());
+		} else if (arg == "--repeat") {
+			res.repeat = static_cast<unsigned>(std::stoul(value()));
+			if (res.repeat == 0) throw std::runtime_error("--repeat must be positive");
+		} else if (arg == "--counters") {
+			res.counters = true;
+		} else if (arg == "--json") {
+			res.json = value();
+		} else {
+			throw std::runtime_error("unknown option: " + arg);
+		}
+	}
+	return res;
+}
+} // namespace
+
+int
+main(int argc, char* argv[]) {
+	bench::Options options;
+	try {
+		options = parseOptions(argc, argv);
+	} catch (const std::exception& e) {
+		std::cerr << "snippets_bench: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<bench::Case> cases;
+	bench::addCurveCases(cases);
+	bench::addFindTupleCases(cases);
+	bench::addFlattenCases(cases);
+	bench::addEnumCases(cases);
+	bench::addPointerCases(cases);
+	if (options.list) {
+		for (const auto& c : cases)
+			std::cout << c.name << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	const auto results = bench::run(cases, options);
+	if (options.json == "-") {
+		std::cout << bench::toJson(results, options);
+	} else if (!options.json.empty()) {
+		std::ofstream out(options.json);
+		out << bench::toJson(results, options);
+		if (!out) {
+			std::cerr << "snippets_bench: cannot write " << options.json << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	return EXIT_SUCCESS;
+}
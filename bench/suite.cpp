@@ -0,0 +1,103 @@
+#include "suite.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace bench {
+
+namespace {
+//! @brief s as a JSON string.
+std::string
+quote(const std::string& s) {
+	std::string res = "\"";
+	for (char c : s) {
+		if (c == '"' || c == '\\') {
+			res += '\\';
+			res += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			const char* hex = "0123456789abcdef";
+			res += "\\u00";
+			res += hex[c >> 4];
+			res += hex[c & 15];
+		} else {
+			res += c;
+		}
+	}
+	return res + '"';
+}
+} // namespace
+
+std::vector<Result>
+run(const std::vector<Case>& cases, const Options& options) {
+	PerfCounters counters;
+	const bool counted = options.counters && counters.available();
+	if (options.counters && !counted)
+		std::cerr << "snippets_bench: hardware counters not available" << std::endl;
+
+	std::vector<Result> results;
+	for (const auto& c : cases) {
+		if (c.name.find(options.filter) == std::string::npos) continue;
+		for (std::size_t size : options.sizes.empty() ? c.sizes : options.sizes) {
+			auto func = c.make(size);
+			Result best{c.name, size, func(), std::numeric_limits<double>::max(),
+			            counted, {0, 0, 0}}; // first run to warm up
+			for (unsigned r = 0; r < options.repeat; ++r) {
+				if (counted) counters.start();
+				const auto start   = std::chrono::steady_clock::now();
+				const auto items   = func();
+				const auto elapsed = std::chrono::steady_clock::now() - start;
+				const auto values  = counted ? counters.stop() : PerfCounters::Values{0, 0, 0};
+				const double ns    = std::chrono::duration<double, std::nano>(elapsed).count();
+				if (ns < best.ns) {
+					best.items    = items;
+					best.ns       = ns;
+					best.counters = values;
+				}
+			}
+			std::cerr << best.name << ", " << size << ", "
+			          << best.ns / double(best.items ? best.items : 1) << " ns/item"
+			          << std::endl;
+			results.push_back(best);
+		}
+	}
+	return results;
+}
+
+std::string
+toJson(const std::vector<Result>& results, const Options& options) {
+	std::ostringstream out;
+	out.precision(9);
+	out << "{\n  \"context\": {\n";
+	out << "    \"compiler\": " << quote(__VERSION__) << ",\n";
+#ifdef NDEBUG
+	out << "    \"optimized\": true,\n";
+#else
+	out << "    \"optimized\": false,\n";
+#endif
+	out << "    \"threads\": " << std::thread::hardware_concurrency() << ",\n";
+	out << "    \"repeat\": " << options.repeat << ",\n";
+	out << "    \"counters\": "
+	    << (!results.empty() && results.front().counted ? "true" : "false") << "\n";
+	out << "  },\n  \"results\": [";
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		const Result& r = results[i];
+		out << (i ? ",\n" : "\n") << "    {\"name\": " << quote(r.name)
+		    << ", \"size\": " << r.size << ", \"items\": " << r.items
+		    << ", \"ns\": " << r.ns
+		    << ", \"ns_per_item\": " << r.ns / double(r.items ? r.items : 1);
+		if (r.counted) {
+			out << ", \"cycles\": " << r.counters.cycles
+			    << ", \"instructions\": " << r.counters.instructions
+			    << ", \"cache_misses\": " << r.counters.cacheMisses;
+		} else {
+			out << ", \"cycles\": null, \"instructions\": null, \"cache_misses\": null";
+		}
+		out << "}";
+	}
+	out << "\n  ]\n}\n";
+	return out.str();
+}
+} // namespace bench
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "perf_counters.hpp"
+
+namespace bench {
+
+//! @brief Prevent the compiler from optimizing value (or its computation) out.
+template <typename T>
+inline void
+keep(const T& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//! @struct Case One benchmark: make(size) prepares the inputs of a size (not
+//! measured) and returns the measured run, which returns the number of items
+//! it processed (e.g. cells, keys, calls) to normalize the results.
+struct Case {
+	std::string name; // "<snippet>/<variant>"
+	std::vector<std::size_t> sizes;
+	std::function<std::function<std::uint64_t()>(std::size_t size)> make;
+};
+
+//! @struct Result Best (fastest) of the repeated runs of a case for a size.
+struct Result {
+	std::string name;
+	std::size_t size;
+	std::uint64_t items;
+	double ns;
+	bool counted; // counters are valid
+	PerfCounters::Values counters;
+};
+
+//! @struct Options Command line of snippets_bench.
+struct Options {
+	std::string filter;             // substring of the case names to run
+	std::vector<std::size_t> sizes; // override the sizes of each case
+	unsigned repeat = 5;
+	bool counters   = false; // hardware counters (perf_event_open)
+	bool list       = false;
+	std::string json; // output file ("-" for stdout)
+};
+
+//! @{
+//! @brief Cases of each snippet.
+void addCurveCases(std::vector<Case>& cases);
+void addFindTupleCases(std::vector<Case>& cases);
+void addFlattenCases(std::vector<Case>& cases);
+void addEnumCases(std::vector<Case>& cases);
+void addPointerCases(std::vector<Case>& cases);
+//! @}
+
+//! @brief Run the selected cases over their sizes (printing a line per result).
+std::vector<Result> run(const std::vector<Case>& cases, const Options& options);
+
+//! @brief Results as a JSON document (with the build and host context).
+std::string toJson(const std::vector<Result>& results, const Options& options);
+} // namespace bench
@@ -1,40 +1,15 @@
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#include "transitive_ptr.hpp"
+
 // Small example where a Class (Foo) contain a polymorphe element (int*)
 // How manage to get transitivity of const ?
 // aka const Foo, imply const x and vice-verca...
 
-namespace std {
-template <class T, class Deleter = std::default_delete<T>>
-class transitive_ptr : public std::unique_ptr<T, Deleter> {
-	public:
-	// inherit typedefs for the sake of completeness
-	typedef typename std::unique_ptr<T, Deleter>::pointer pointer;
-	typedef typename std::unique_ptr<T, Deleter>::element_type element_type;
-	typedef typename std::unique_ptr<T, Deleter>::deleter_type deleter_type;
-
-	// extra typedef
-	typedef const typename std::remove_pointer<pointer>::type* const_pointer;
-
-	// inherit std::unique_ptr's constructors
-	using std::unique_ptr<T, Deleter>::unique_ptr;
-
-	// add transitively const version of get()
-	pointer get() { return std::unique_ptr<T, Deleter>::get(); }
-	const_pointer get() const { return std::unique_ptr<T, Deleter>::get(); }
-
-	// add transitively const version of operator*()
-	typename std::add_lvalue_reference<T>::type operator*() { return *get(); }
-	typename std::add_lvalue_reference<const T>::type operator*() const { return *get(); }
-
-	// add transitively const version of operator->()
-	pointer operator->() { return get(); }
-	const_pointer operator->() const { return get(); }
-};
-}
-
 struct Foo {
 	int a;
 };
@@ -46,7 +21,7 @@ struct Bar {
 	  , z(new Foo) {}
 	std::unique_ptr<Foo> x;
 	std::unique_ptr<const Foo> y;
-	std::transitive_ptr<Foo> z;
+	snippets::transitive_ptr<Foo> z;
 
 	void constMethod() const {
 		x->a = 42;
@@ -60,6 +35,31 @@ struct Bar {
 	}
 };
 
+// Same without a malloc per member: from the thread pool of Foo...
+struct PooledBar {
+	PooledBar()
+	  : z(snippets::make_pooled<Foo>()) {}
+	snippets::pooled_ptr<Foo> z;
+
+	void constMethod() const {
+		// z->a = 42; // GOOD method is const thus z is const !
+	}
+	void method() { z->a = 42; }
+};
+
+// ... or stored inline (no allocation at all).
+struct InlineBar {
+	snippets::transitive_value<Foo> z;
+
+	void constMethod() const {
+		// z->a = 42; // GOOD method is const thus z is const !
+	}
+	void method() { z->a = 42; }
+};
+
+template <typename T>
+using IsConst = std::is_const<typename std::remove_reference<T>::type>;
+
 int
 main() {
 	Bar a;
@@ -69,6 +69,37 @@ main() {
 	const Bar b;
 	b.constMethod();
 	// b.method(); // b is const !
+
+	PooledBar c;
+	c.method();
+	const PooledBar& cc = c;
+	static_assert(!IsConst<decltype(*c.z)>::value && IsConst<decltype(*cc.z)>::value &&
+	                IsConst<decltype((cc.z->a))>::value,
+	              "pooled");
+	static_assert(sizeof(c.z) == sizeof(Foo*), "pooled_ptr size");
+	static_assert(!std::is_constructible<snippets::pooled_ptr<Foo>, Foo*>::value,
+	              "only make_pooled fills the pool");
+
+	InlineBar d;
+	d.method();
+	const InlineBar& dc = d;
+	static_assert(!IsConst<decltype(*d.z)>::value && IsConst<decltype(*dc.z)>::value &&
+	                IsConst<decltype((dc.z->a))>::value,
+	              "inline");
+	static_assert(sizeof(InlineBar) == sizeof(Foo), "transitive_value size");
+	if (c.z->a != 42 || dc.z->a != 42) throw std::runtime_error("transitive mismatch");
+
+	// A released slot is the next one given by the pool.
+	const Foo* previous = c.z.get();
+	c.z.reset();
+	if (snippets::make_pooled<Foo>().get() != previous)
+		throw std::runtime_error("pool reuse");
+	std::vector<snippets::pooled_ptr<Foo>> foos;
+	for (int i = 0; i < 100000; ++i)
+		foos.push_back(snippets::make_pooled<Foo>(Foo{i}));
+	for (int i = 0; i < 100000; ++i) {
+		if (foos[i]->a != i) throw std::runtime_error("pool mismatch");
+	}
 }
 
 //  // Big Five
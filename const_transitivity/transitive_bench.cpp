@@ -0,0 +1,73 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "transitive_ptr.hpp"
+#include "measure.hpp"
+
+// Create then destroy batches of Bar-like objects with three Foo members:
+// transitive_ptr (one new per member), pooled_ptr (thread pool of Foo)
+// and transitive_value (inline).
+// usage: TransitiveBench [objects] [rounds]
+
+struct Foo {
+	int a;
+};
+
+struct HeapBar {
+	HeapBar(int i)
+	  : x(new Foo{i})
+	  , y(new Foo{i})
+	  , z(new Foo{i}) {}
+	int sum() const { return x->a + y->a + z->a; }
+	snippets::transitive_ptr<Foo> x, y, z;
+};
+
+struct PooledBar {
+	PooledBar(int i)
+	  : x(snippets::make_pooled<Foo>(Foo{i}))
+	  , y(snippets::make_pooled<Foo>(Foo{i}))
+	  , z(snippets::make_pooled<Foo>(Foo{i})) {}
+	int sum() const { return x->a + y->a + z->a; }
+	snippets::pooled_ptr<Foo> x, y, z;
+};
+
+struct InlineBar {
+	InlineBar(int i)
+	  : x(Foo{i})
+	  , y(Foo{i})
+	  , z(Foo{i}) {}
+	int sum() const { return x->a + y->a + z->a; }
+	snippets::transitive_value<Foo> x, y, z;
+};
+
+using bench::measure;
+
+template <typename Bar>
+void
+run(const char* name, int count, int rounds) {
+	long sum       = 0;
+	double elapsed = measure([&] {
+		for (int r = 0; r < rounds; ++r) {
+			std::vector<Bar> bars;
+			bars.reserve(count);
+			for (int i = 0; i < count; ++i)
+				bars.emplace_back(i);
+			for (const auto& bar : bars)
+				sum += bar.sum();
+		}
+	});
+	std::cout << name << ": " << elapsed / (static_cast<double>(count) * rounds)
+	          << " ns per Bar (create, read, destroy)" << std::endl;
+	if (sum == 42) std::cout << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const int count  = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	const int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+	run<HeapBar>("transitive_ptr  ", count, rounds);
+	run<PooledBar>("pooled_ptr      ", count, rounds);
+	run<InlineBar>("transitive_value", count, rounds);
+}
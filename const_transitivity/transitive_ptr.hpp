@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Project namespace: user templates must not be added to namespace std.
+namespace snippets {
+template <class T, class Deleter = std::default_delete<T>>
+class transitive_ptr : public std::unique_ptr<T, Deleter> {
+	public:
+	// inherit typedefs for the sake of completeness
+	typedef typename std::unique_ptr<T, Deleter>::pointer pointer;
+	typedef typename std::unique_ptr<T, Deleter>::element_type element_type;
+	typedef typename std::unique_ptr<T, Deleter>::deleter_type deleter_type;
+
+	// extra typedef
+	typedef const typename std::remove_pointer<pointer>::type* const_pointer;
+
+	// inherit std::unique_ptr's constructors
+	using std::unique_ptr<T, Deleter>::unique_ptr;
+
+	// add transitively const version of get()
+	pointer get() { return std::unique_ptr<T, Deleter>::get(); }
+	const_pointer get() const { return std::unique_ptr<T, Deleter>::get(); }
+
+	// add transitively const version of operator*()
+	typename std::add_lvalue_reference<T>::type operator*() { return *get(); }
+	typename std::add_lvalue_reference<const T>::type operator*() const { return *get(); }
+
+	// add transitively const version of operator->()
+	pointer operator->() { return get(); }
+	const_pointer operator->() const { return get(); }
+};
+
+// Same interface as transitive_ptr but the object is stored inline (no heap
+// allocation at all), for small objects which do not need to be polymorphic
+// nor to change owner.
+template <class T>
+class transitive_value {
+	public:
+	typedef T* pointer;
+	typedef T element_type;
+	typedef const T* const_pointer;
+
+	template <class... Args,
+	          class = typename std::enable_if<
+	            std::is_constructible<T, Args...>::value>::type>
+	explicit transitive_value(Args&&... args)
+	  : _value(std::forward<Args>(args)...) {}
+
+	pointer get() { return &_value; }
+	const_pointer get() const { return &_value; }
+
+	T& operator*() { return _value; }
+	const T& operator*() const { return _value; }
+
+	pointer operator->() { return get(); }
+	const_pointer operator->() const { return get(); }
+
+	private:
+	T _value;
+};
+
+//! @class Pool Free list of fixed size slots for objects of type T, the slots
+//! are allocated by chunks of about 64KiB which are released with the pool.
+//! Allocation and deallocation are a pop and a push on the free list.
+template <typename T>
+class Pool {
+	public:
+	Pool() = default;
+	Pool(const Pool&) = delete;
+	Pool& operator=(const Pool&) = delete;
+
+	//! @brief Uninitialized storage for one T.
+	void* allocate() {
+		if (!_free) grow();
+		Slot* slot = _free;
+		_free      = slot->next;
+		return slot;
+	}
+
+	//! @brief Give back a storage from allocate() (the T is already destroyed).
+	void deallocate(void* ptr) noexcept {
+		Slot* slot = static_cast<Slot*>(ptr);
+		slot->next = _free;
+		_free      = slot;
+	}
+
+	//! @brief True if ptr is a slot of this pool (linear in the chunks, for
+	//! assertions).
+	bool owns(const void* ptr) const {
+		const Slot* slot = static_cast<const Slot*>(ptr);
+		std::less_equal<const Slot*> le;
+		for (const auto& chunk : _chunks) {
+			if (le(chunk.get(), slot) && !le(chunk.get() + kChunkSize, slot)) return true;
+		}
+		return false;
+	}
+
+	//! @brief Pool of the calling thread (no locking): pooled objects must be
+	//! destroyed by the thread which created them (asserted by PoolDelete).
+	static Pool& local() {
+		thread_local Pool pool;
+		return pool;
+	}
+
+	private:
+	union Slot {
+		Slot* next;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+	};
+
+	static constexpr std::size_t kChunkSize =
+	  sizeof(Slot) < (1 << 16) ? (1 << 16) / sizeof(Slot) : 1;
+
+	void grow() {
+		Slot* chunk = new Slot[kChunkSize];
+		_chunks.emplace_back(chunk);
+		for (std::size_t i = kChunkSize; i > 0; --i)
+			deallocate(&chunk[i - 1]);
+	}
+
+	std::vector<std::unique_ptr<Slot[]>> _chunks;
+	Slot* _free = nullptr;
+};
+
+//! @struct PoolDelete Deleter of the objects from make_pooled (empty, so a
+//! pooled_ptr is the size of a raw pointer). The slot goes back to the pool of
+//! the calling thread, which must be the creating one: a pooled_ptr may be
+//! moved to another thread but not destroyed there.
+template <typename T>
+struct PoolDelete {
+	void operator()(T* ptr) const {
+		auto& pool = Pool<typename std::remove_const<T>::type>::local();
+		assert(pool.owns(ptr) && "pooled object destroyed by another thread");
+		ptr->~T();
+		pool.deallocate(const_cast<typename std::remove_const<T>::type*>(ptr));
+	}
+};
+
+template <typename T>
+class pooled_ptr;
+
+template <typename T, typename... Args>
+pooled_ptr<T> make_pooled(Args&&... args);
+
+//! @class pooled_ptr transitive_ptr on an object of the thread pool of T
+//! (exactly T, not a derived class). Only make_pooled creates the object, so
+//! the pool never receives memory it did not allocate.
+template <typename T>
+class pooled_ptr {
+	public:
+	typedef T* pointer;
+	typedef T element_type;
+	typedef const T* const_pointer;
+
+	pooled_ptr() = default;
+	pooled_ptr(std::nullptr_t) {}
+
+	pointer get() { return _ptr.get(); }
+	const_pointer get() const { return _ptr.get(); }
+
+	T& operator*() { return *_ptr; }
+	const T& operator*() const { return *_ptr; }
+
+	pointer operator->() { return get(); }
+	const_pointer operator->() const { return get(); }
+
+	explicit operator bool() const { return static_cast<bool>(_ptr); }
+	void reset() { _ptr.reset(); }
+
+	private:
+	template <typename U, typename... Args>
+	friend pooled_ptr<U> make_pooled(Args&&... args);
+
+	explicit pooled_ptr(T* ptr)
+	  : _ptr(ptr) {}
+
+	transitive_ptr<T, PoolDelete<T>> _ptr;
+};
+
+template <typename T, typename... Args>
+pooled_ptr<T>
+make_pooled(Args&&... args) {
+	using Type = typename std::remove_const<T>::type;
+	auto& pool = Pool<Type>::local();
+	void* ptr  = pool.allocate();
+	try {
+		return pooled_ptr<T>(::new (ptr) Type(std::forward<Args>(args)...));
+	} catch (...) {
+		pool.deallocate(ptr);
+		throw;
+	}
+}
+} // namespace snippets
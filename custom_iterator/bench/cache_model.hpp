@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! @class CacheModel Set associative LRU cache counting misses.
+class CacheModel {
+	public:
+	CacheModel(std::size_t size, std::size_t ways = 8, std::size_t line = 64)
+	  : _ways(ways)
+	  , _line(line)
+	  , _sets(size / (ways * line))
+	  , _tags(_sets * ways, ~std::uintptr_t(0))
+	  , _misses(0) {}
+
+	void access(const void* ptr) {
+		const std::uintptr_t tag = reinterpret_cast<std::uintptr_t>(ptr) / _line;
+		std::uintptr_t* set      = &_tags[(tag % _sets) * _ways];
+		std::size_t way          = 0;
+		while (way < _ways - 1 && set[way] != tag) ++way;
+		if (set[way] != tag) ++_misses; // evict the LRU (i.e. last) way
+		for (; way > 0; --way)
+			set[way] = set[way - 1];
+		set[0] = tag;
+	}
+
+	std::size_t misses() const { return _misses; }
+
+	private:
+	std::size_t _ways;
+	std::size_t _line;
+	std::size_t _sets;
+	std::vector<std::uintptr_t> _tags; // per set, most recently used first
+	std::size_t _misses;
+};
@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include <graycode_iterator.hpp>
+#include <hilbert_iterator.hpp>
+#include <matrix.hpp>
+#include <morton_iterator.hpp>
+
+#include "measure.hpp"
+
+// Per element cost of a sum over the curve iterators with the Checked and
+// Unchecked policies (i.e. with and without the throwing checks of operator*
+// and operator==), the row major pointer loop being the lower bound.
+// usage: CheckBench [log2(n)] [repeat]
+
+using bench::measure;
+
+template <typename Iterator>
+long
+sum(Iterator first, Iterator last) {
+	long res = 0;
+	for (; first != last; ++first)
+		res += *first;
+	return res;
+}
+
+template <typename Iterator>
+void
+run(const char* name, Iterator it, std::size_t size, int repeat) {
+	long res    = 0;
+	double time = measure([&]() {
+		for (int r = 0; r < repeat; ++r)
+			res += sum(it.begin(), it.end());
+	});
+	std::cout << name << ", " << time / (double(size) * repeat) << " (" << res << ")"
+	          << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t order = argc > 1 ? std::atoi(argv[1]) : 10;
+	const int repeat        = argc > 2 ? std::atoi(argv[2]) : 10;
+
+	Matrix<int> mat(std::size_t(1) << order, 1);
+	std::cout << "n: " << mat.n << std::endl;
+	std::cout << "iterator, time (ns/element)" << std::endl;
+
+	long res    = 0;
+	double time = measure([&]() {
+		for (int r = 0; r < repeat; ++r)
+			res += sum(mat.data.get(), mat.data.get() + mat.size());
+	});
+	std::cout << "pointer, " << time / (double(mat.size()) * repeat) << " (" << res << ")"
+	          << std::endl;
+	run("hilbert checked",
+	    hilbert::iterator<int, RowMajor, Checked>(mat),
+	    mat.size(),
+	    repeat);
+	run("hilbert unchecked",
+	    hilbert::iterator<int, RowMajor, Unchecked>(mat),
+	    mat.size(),
+	    repeat);
+	run("graycode checked",
+	    graycode::iterator<int, RowMajor, Checked>(mat),
+	    mat.size(),
+	    repeat);
+	run("graycode unchecked",
+	    graycode::iterator<int, RowMajor, Unchecked>(mat),
+	    mat.size(),
+	    repeat);
+	run("morton checked",
+	    morton::iterator<int, RowMajor, Checked>(mat),
+	    mat.size(),
+	    repeat);
+	run("morton unchecked",
+	    morton::iterator<int, RowMajor, Unchecked>(mat),
+	    mat.size(),
+	    repeat);
+}
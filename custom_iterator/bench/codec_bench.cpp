@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <graycode_codec.hpp>
+#include <hilbert_codec.hpp>
+
+#include "measure.hpp"
+
+// Throughput of the curve encode/decode backends on random 64 bits keys, one key
+// at a time then using the batch API.
+// usage: CodecBench [order] [count]
+
+using bench::measure;
+
+const char*
+name(Backend backend) {
+	switch (backend) {
+		case Backend::Scalar:
+			return "Scalar";
+		case Backend::Table:
+			return "Table";
+		case Backend::BMI2:
+			return "BMI2";
+		case Backend::AVX2:
+			return "AVX2";
+		case Backend::AVX512:
+			return "AVX512";
+	}
+	return "";
+}
+
+int
+main(int argc, char* argv[]) {
+	const unsigned order     = argc > 1 ? std::atoi(argv[1]) : 32;
+	const std::size_t count  = argc > 2 ? std::atoi(argv[2]) : (1 << 22);
+	const std::uint64_t mask = (std::uint64_t(1) << order) - 1;
+
+	std::mt19937_64 gen(42);
+	std::vector<std::uint32_t> xs(count), ys(count);
+	std::vector<std::uint64_t> keys(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		xs[i] = gen() & mask;
+		ys[i] = gen() & mask;
+	}
+
+	std::vector<Backend> backends = {Backend::Scalar, Backend::Table};
+	if (hasBMI2()) backends.push_back(Backend::BMI2);
+
+	std::cout << "order: " << order << ", count: " << count << std::endl;
+	std::cout << "curve, backend, encode (ns/key), decode (ns/key)" << std::endl;
+	for (auto backend : backends) {
+		std::uint64_t check = 0;
+		double enc = measure([&]() {
+			for (std::size_t i = 0; i < count; ++i)
+				keys[i] = hilbert::encode(backend, xs[i], ys[i], order);
+		});
+		double dec = measure([&]() {
+			for (std::size_t i = 0; i < count; ++i)
+				check += hilbert::decode(backend, keys[i], order).x;
+		});
+		std::cout << "hilbert, " << name(backend) << ", " << enc / count << ", "
+		          << dec / count << " (" << check << ")" << std::endl;
+	}
+	for (auto backend : backends) {
+		std::uint64_t check = 0;
+		for (std::size_t i = 0; i < count; ++i)
+			keys[i] = graycode::encode(xs[i], ys[i], order);
+		double dec = measure([&]() {
+			for (std::size_t i = 0; i < count; ++i)
+				check += graycode::decode(backend, keys[i], order).x;
+		});
+		std::cout << "graycode, " << name(backend) << ", -, " << dec / count << " ("
+		          << check << ")" << std::endl;
+	}
+
+	if (hasAVX2()) backends.push_back(Backend::AVX2);
+	if (hasAVX512()) backends.push_back(Backend::AVX512);
+	std::vector<std::uint32_t> rxs(count), rys(count);
+	std::cout << "curve, batch backend, encode (ns/key), decode (ns/key)" << std::endl;
+	for (auto backend : backends) {
+		double enc = measure([&]() {
+			hilbert::encodeBatch(backend, xs.data(), ys.data(), keys.data(), count, order);
+		});
+		double dec = measure([&]() {
+			hilbert::decodeBatch(backend, keys.data(), rxs.data(), rys.data(), count, order);
+		});
+		std::cout << "hilbert, " << name(backend) << ", " << enc / count << ", "
+		          << dec / count << " (" << rxs[count / 2] << ")" << std::endl;
+	}
+	for (auto backend : backends) {
+		double enc = measure([&]() {
+			graycode::encodeBatch(backend, xs.data(), ys.data(), keys.data(), count, order);
+		});
+		double dec = measure([&]() {
+			graycode::decodeBatch(backend, keys.data(), rxs.data(), rys.data(), count, order);
+		});
+		std::cout << "graycode, " << name(backend) << ", " << enc / count << ", "
+		          << dec / count << " (" << rxs[count / 2] << ")" << std::endl;
+	}
+}
@@ -0,0 +1,100 @@
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <grid.hpp>
+#include <hilbert_grid.hpp>
+#include <morton_grid.hpp>
+
+#include "cache_model.hpp"
+#include "measure.hpp"
+
+// Cache behavior of a 7 points stencil (cell + 6 neighbors) applied on a 3D
+// grid in row major, Morton and Hilbert order (same cache model as
+// TraversalBench), then the 3D encode/decode throughput.
+// usage: GridBench [log2(n)] [cache size (KiB)]
+
+using bench::measure;
+
+//! @brief Apply the stencil on each cell visited by [first, last).
+//! visit(ptr) is called on each accessed element.
+template <typename Iterator, typename Visitor>
+long
+stencil(Grid<int, 3>& grid, Iterator first, Iterator last, Visitor&& visit) {
+	const int* base = grid.get();
+	const long n    = static_cast<long>(grid.n);
+	const long nn   = n * n;
+	long sum        = 0;
+	for (; first != last; ++first) {
+		const int* p  = &*first;
+		const long id = p - base;
+		const long x  = id % n;
+		const long y  = (id / n) % n;
+		const long z  = id / nn;
+		visit(p);
+		sum += *p;
+		if (x > 0) visit(p - 1), sum += p[-1];
+		if (x < n - 1) visit(p + 1), sum += p[1];
+		if (y > 0) visit(p - n), sum += p[-n];
+		if (y < n - 1) visit(p + n), sum += p[n];
+		if (z > 0) visit(p - nn), sum += p[-nn];
+		if (z < n - 1) visit(p + nn), sum += p[nn];
+	}
+	return sum;
+}
+
+template <typename Iterator>
+void
+run(const char* name,
+    Grid<int, 3>& grid,
+    Iterator first,
+    Iterator last,
+    std::size_t cache) {
+	long sum    = 0;
+	double time = measure([&]() { sum = stencil(grid, first, last, [](const int*) {}); });
+	CacheModel model(cache);
+	stencil(grid, first, last, [&model](const int* p) { model.access(p); });
+	std::cout << name << ", " << time / grid.size() << ", "
+	          << double(model.misses()) / grid.size() << " (" << sum << ")" << std::endl;
+}
+
+template <typename Curve>
+void
+codec(const char* name, unsigned order) {
+	const std::uint64_t count = std::uint64_t(1) << (3 * order);
+	std::uint64_t sum         = 0;
+	double decode             = measure([&]() {
+		for (std::uint64_t d = 0; d < count; ++d) {
+			const auto p = Curve::decode(d, order);
+			sum += p[0] ^ p[1] ^ p[2];
+		}
+	});
+	double encode = measure([&]() {
+		for (std::uint64_t d = 0; d < count; ++d)
+			sum += Curve::encode({std::uint32_t(d), std::uint32_t(d >> 3), 0}, order);
+	});
+	std::cout << name << ", " << encode / count << ", " << decode / count << " (" << sum
+	          << ")" << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const unsigned order    = argc > 1 ? std::atoi(argv[1]) : 8;
+	const std::size_t cache = (argc > 2 ? std::atoi(argv[2]) : 32) * 1024;
+
+	Grid<int, 3> grid(std::size_t(1) << order, 1);
+	std::cout << "n: " << grid.n << "^3, cache model: " << cache / 1024 << " KiB"
+	          << std::endl;
+	std::cout << "traversal, time (ns/cell), misses (per cell)" << std::endl;
+	run("row major", grid, grid.begin(), grid.end(), cache);
+	morton::grid_iterator<int, 3, Unchecked> morton(grid);
+	run("morton", grid, morton.begin(), morton.end(), cache);
+	hilbert::grid_iterator<int, 3, Unchecked> hilbert(grid);
+	run("hilbert", grid, hilbert.begin(), hilbert.end(), cache);
+
+	std::cout << "codec, encode (ns/key), decode (ns/key)" << std::endl;
+	codec<morton::GridCurve<3>>("morton", order);
+	codec<hilbert::GridCurve<3>>("hilbert", order);
+}
@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <hilbert_iterator.hpp>
+#include <matrix.hpp>
+
+#include "measure.hpp"
+
+// Compare the legacy Hilbert traversal (i.e. one BinaryToXY() per element, the
+// original loop, not the dispatched codec behind hilbert::iterator::BinaryToXY)
+// against the incremental hilbert::iterator.
+// usage: HilbertBench [log2(n) min] [log2(n) max]
+
+using bench::measure;
+
+namespace {
+// rotate/flip a quadrant appropriately
+inline void
+rot(std::size_t n, std::size_t& x, std::size_t& y, std::size_t rx, std::size_t ry) {
+	if (ry == 0) {
+		if (rx == 1) {
+			x = n - 1 - x;
+			y = n - 1 - y;
+		}
+		// Swap x and y
+		std::size_t t = x;
+		x             = y;
+		y             = t;
+	}
+}
+
+//! @brief Cell of the curve index d on a n x n matrix (original loop).
+Vector<std::size_t>
+BinaryToXY(std::size_t d, std::size_t n) {
+	if (d > n * n - 1) throw std::range_error("Distance must be in range [0, n^2-1]");
+
+	Vector<std::size_t> out(0, 0);
+	std::size_t rx, ry, s, t = d;
+	for (s = 1; s < n; s *= 2) {
+		rx = 1 & (t / 2);
+		ry = 1 & (t ^ rx);
+		rot(s, out.x, out.y, rx, ry);
+		out.x += s * rx;
+		out.y += s * ry;
+		t /= 4;
+	}
+	return out;
+}
+} // namespace
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t minLog = argc > 1 ? std::atoi(argv[1]) : 10;
+	const std::size_t maxLog = argc > 2 ? std::atoi(argv[2]) : 14;
+
+	std::cout << "n, legacy (ns/elt), incremental (ns/elt), speedup" << std::endl;
+	for (std::size_t l = minLog; l <= maxLog; ++l) {
+		Matrix<std::uint8_t> mat(std::size_t(1) << l);
+		hilbert::iterator<std::uint8_t> it(mat);
+
+		double legacy = measure([&]() {
+			std::uint8_t value = 0;
+			for (std::size_t d = 0; d < mat.size(); ++d) {
+				auto xy         = BinaryToXY(d, mat.n);
+				mat(xy.x, xy.y) = value++;
+			}
+		});
+		double incremental =
+		  measure([&]() { std::iota(it.begin(), it.end(), std::uint8_t(0)); });
+
+		legacy /= mat.size();
+		incremental /= mat.size();
+		std::cout << mat.n << ", " << legacy << ", " << incremental << ", "
+		          << legacy / incremental << std::endl;
+	}
+}
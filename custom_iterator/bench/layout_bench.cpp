@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hilbert_iterator.hpp>
+#include <matrix.hpp>
+#include <morton_iterator.hpp>
+
+#include "cache_model.hpp"
+#include "measure.hpp"
+
+// Compare the Matrix layouts (RowMajor, Morton and Hilbert tiles) on:
+// - a 5 points stencil in row major order and in hilbert order,
+// - random w x w window queries (cache misses and distinct 4 KiB pages).
+// usage: LayoutBench [log2(n)] [window size] [cache size (KiB)]
+
+using bench::measure;
+
+//! @brief 5 points stencil on the cell (x, y), visit(ptr) is called on each
+//! accessed element.
+template <typename Layout, typename Visitor>
+long
+stencil(const Matrix<int, Layout>& mat, std::size_t x, std::size_t y, Visitor&& visit) {
+	long sum    = 0;
+	auto access = [&](std::size_t i, std::size_t j) {
+		const int& v = mat(i, j);
+		visit(&v);
+		sum += v;
+	};
+	access(x, y);
+	if (x > 0) access(x - 1, y);
+	if (x < mat.n - 1) access(x + 1, y);
+	if (y > 0) access(x, y - 1);
+	if (y < mat.n - 1) access(x, y + 1);
+	return sum;
+}
+
+template <typename Layout>
+void
+run(const char* name, std::size_t order, std::size_t window, std::size_t cache) {
+	Matrix<int, Layout> mat(std::size_t(1) << order, 1);
+	const double cells = static_cast<double>(mat.size());
+	auto noop          = [](const int*) {};
+
+	// Stencil in row major order
+	long sum         = 0;
+	double rowMajor = measure([&]() {
+		for (std::size_t y = 0; y < mat.n; ++y) {
+			for (std::size_t x = 0; x < mat.n; ++x)
+				sum += stencil(mat, x, y, noop);
+		}
+	});
+	CacheModel rowModel(cache);
+	for (std::size_t y = 0; y < mat.n; ++y) {
+		for (std::size_t x = 0; x < mat.n; ++x)
+			stencil(mat, x, y, [&](const int* p) { rowModel.access(p); });
+	}
+
+	// Stencil in hilbert order
+	hilbert::iterator<int, Layout> it(mat);
+	std::vector<Vector<std::size_t>> cellsOrder;
+	cellsOrder.reserve(mat.size());
+	for (std::size_t d = 0; d < mat.size(); ++d)
+		cellsOrder.push_back(it.BinaryToXY(d));
+	double curve = measure([&]() {
+		for (const auto& c : cellsOrder)
+			sum += stencil(mat, c.x, c.y, noop);
+	});
+	CacheModel curveModel(cache);
+	for (const auto& c : cellsOrder)
+		stencil(mat, c.x, c.y, [&](const int* p) { curveModel.access(p); });
+
+	// Random window queries
+	const std::size_t queries = 4096;
+	std::mt19937_64 gen(42);
+	std::uniform_int_distribution<std::size_t> dist(0, mat.n - window);
+	std::vector<Vector<std::size_t>> corners;
+	for (std::size_t q = 0; q < queries; ++q)
+		corners.emplace_back(dist(gen), dist(gen));
+	double windows = measure([&]() {
+		for (const auto& c : corners) {
+			for (std::size_t y = c.y; y < c.y + window; ++y) {
+				for (std::size_t x = c.x; x < c.x + window; ++x)
+					sum += mat(x, y);
+			}
+		}
+	});
+	CacheModel windowModel(cache);
+	std::size_t pages = 0;
+	std::vector<std::uintptr_t> touched;
+	for (const auto& c : corners) {
+		touched.clear();
+		for (std::size_t y = c.y; y < c.y + window; ++y) {
+			for (std::size_t x = c.x; x < c.x + window; ++x) {
+				windowModel.access(&mat(x, y));
+				touched.push_back(reinterpret_cast<std::uintptr_t>(&mat(x, y)) >> 12);
+			}
+		}
+		std::sort(touched.begin(), touched.end());
+		pages += std::unique(touched.begin(), touched.end()) - touched.begin();
+	}
+
+	const double windowCells = static_cast<double>(queries * window * window);
+	std::cout << name << ", " << rowMajor / cells << ", " << rowModel.misses() / cells
+	          << ", " << curve / cells << ", " << curveModel.misses() / cells << ", "
+	          << windows / windowCells << ", " << windowModel.misses() / double(queries)
+	          << ", " << pages / double(queries) << " (" << sum << ")" << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t order  = argc > 1 ? std::atoi(argv[1]) : 11;
+	const std::size_t window = argc > 2 ? std::atoi(argv[2]) : 32;
+	const std::size_t cache  = (argc > 3 ? std::atoi(argv[3]) : 32) * 1024;
+
+	std::cout << "n: " << (1 << order) << ", window: " << window
+	          << ", cache model: " << cache / 1024 << " KiB" << std::endl;
+	std::cout << "layout, row major stencil (ns/cell), misses (per cell), "
+	             "hilbert stencil (ns/cell), misses (per cell), "
+	             "window (ns/cell), misses (per query), pages (per query)"
+	          << std::endl;
+	run<RowMajor>("row major", order, window, cache);
+	run<morton::TiledLayout<>>("morton tiles", order, window, cache);
+	run<hilbert::TiledLayout<>>("hilbert tiles", order, window, cache);
+}
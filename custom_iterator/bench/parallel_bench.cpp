@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include <hilbert_iterator.hpp>
+#include <matrix.hpp>
+#include <parallel_for_curve.hpp>
+
+#include "measure.hpp"
+
+// Scaling of parallel_for_curve over a hilbert traversal from 1 to N workers.
+// The kernel is a few rounds of integer hashing per cell so the run is not
+// only bound by the memory bandwidth.
+// usage: ParallelBench [log2(n)] [max workers] [rounds]
+
+using bench::measure;
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t order = argc > 1 ? std::atoi(argv[1]) : 12;
+	const unsigned cores    = std::max(1u, std::thread::hardware_concurrency());
+	const unsigned workers  = argc > 2 ? std::atoi(argv[2]) : cores;
+	const int rounds        = argc > 3 ? std::atoi(argv[3]) : 16;
+
+	Matrix<std::uint32_t> mat(std::size_t(1) << order, 1);
+	auto kernel = [rounds](std::uint32_t& v) {
+		std::uint32_t h = v;
+		for (int r = 0; r < rounds; ++r)
+			h = (h ^ (h >> 16)) * 0x45D9F3B;
+		v = h;
+	};
+
+	std::cout << "n: " << mat.n << ", rounds: " << rounds << std::endl;
+	std::cout << "workers, time (ms), time (ns/cell), speedup" << std::endl;
+	double reference = 0;
+	for (unsigned w = 1; w <= workers; ++w) {
+		ThreadPool pool(w);
+		parallel_for_curve(mat, hilbert::Curve{}, kernel, pool); // warm up
+		const double time =
+		  measure([&]() { parallel_for_curve(mat, hilbert::Curve{}, kernel, pool); });
+		if (w == 1) reference = time;
+		std::cout << w << ", " << time / 1e6 << ", " << time / mat.size() << ", "
+		          << reference / time << std::endl;
+	}
+	std::cout << "(" << mat(0, 0) << ")" << std::endl;
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <curve_ranges.hpp>
+#include <graycode_iterator.hpp>
+#include <hilbert_iterator.hpp>
+#include <morton_iterator.hpp>
+
+#include "measure.hpp"
+
+// Window queries on random points: full scan of the points against the keys
+// sorted by curve index, with curve_ranges() (exact and bounded to 16
+// intervals) and a binary search per interval (points of the bounded
+// intervals are filtered).
+// usage: RangeBench [points] [queries] [window side]
+
+using bench::measure;
+
+struct Window {
+	Vector<std::uint32_t> min;
+	Vector<std::uint32_t> max;
+};
+
+template <typename Curve>
+void
+run(const char* name,
+    const std::vector<Vector<std::uint32_t>>& points,
+    const std::vector<Window>& windows,
+    unsigned order) {
+	std::vector<std::uint64_t> keys;
+	keys.reserve(points.size());
+	for (const auto& p : points)
+		keys.push_back(Curve::encode(p.x, p.y, order));
+	std::sort(keys.begin(), keys.end());
+
+	auto inside = [order](std::uint64_t key, const Window& w) {
+		const auto xy = Curve::decode(key, order);
+		return xy.x >= w.min.x && xy.x <= w.max.x && xy.y >= w.min.y && xy.y <= w.max.y;
+	};
+	long scanned = 0, found = 0, bounded = 0, intervals = 0;
+	const double scan = measure([&] {
+		for (const auto& w : windows)
+			scanned += std::count_if(points.begin(), points.end(), [&](const auto& p) {
+				return p.x >= w.min.x && p.x <= w.max.x && p.y >= w.min.y && p.y <= w.max.y;
+			});
+	});
+	auto query = [&](std::size_t maxRanges, long& count) {
+		for (const auto& w : windows) {
+			const auto ranges = curve_ranges<Curve>(w.min, w.max, order, maxRanges);
+			if (maxRanges == 0) intervals += ranges.size();
+			for (const auto& r : ranges) {
+				auto first = std::lower_bound(keys.begin(), keys.end(), r.first);
+				auto last  = std::upper_bound(first, keys.end(), r.last);
+				count += maxRanges ? std::count_if(first,
+				                                   last,
+				                                   [&](std::uint64_t key) {
+					                                   return inside(key, w);
+				                                   })
+				                   : last - first;
+			}
+		}
+	};
+	const double exact = measure([&] { query(0, found); });
+	const double few   = measure([&] { query(16, bounded); });
+	const double count = static_cast<double>(windows.size());
+	std::cout << name << ", " << scan / count << ", " << exact / count << ", "
+	          << few / count << ", " << intervals / count
+	          << (scanned == found && found == bounded ? "" : " (wrong result)")
+	          << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t count   = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	const std::size_t queries = argc > 2 ? std::atoi(argv[2]) : 100;
+	const std::uint32_t size  = argc > 3 ? std::atoi(argv[3]) : 1000;
+	const unsigned order      = 16;
+
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<std::uint32_t> coord(0, (1u << order) - 1);
+	std::uniform_int_distribution<std::uint32_t> corner(0, (1u << order) - size);
+	std::vector<Vector<std::uint32_t>> points;
+	for (std::size_t i = 0; i < count; ++i)
+		points.emplace_back(coord(gen), coord(gen));
+	std::vector<Window> windows;
+	for (std::size_t i = 0; i < queries; ++i) {
+		const auto min = Vector<std::uint32_t>(corner(gen), corner(gen));
+		windows.push_back({min, Vector<std::uint32_t>(min.x + size - 1, min.y + size - 1)});
+	}
+
+	std::cout << "points: " << count << ", window: " << size << "^2 in 2^" << order
+	          << " square" << std::endl;
+	std::cout << "curve, scan (ns/query), ranges (ns/query), 16 ranges (ns/query), "
+	             "intervals (per query)"
+	          << std::endl;
+	run<hilbert::Curve>("hilbert", points, windows, order);
+	run<morton::Curve>("morton", points, windows, order);
+	run<graycode::Curve>("graycode", points, windows, order);
+}
@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <utility>
+
+#include <matrix.hpp>
+#include <matrix_io.hpp>
+
+#include "measure.hpp"
+
+// Dump of a n x n Matrix<int> with the text operator<< against the binary
+// save(), then restart: the first element read from the mapped file and a
+// whole sum of the mapped matrix (i.e. reading every page).
+// usage: SerializeBench [n] [directory]
+
+using bench::measure;
+
+//! @brief Wall time of func() in milliseconds.
+template <typename F>
+double
+measureMs(F&& func) {
+	return measure(std::forward<F>(func)) / 1e6;
+}
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t n = argc > 1 ? std::atoi(argv[1]) : 4096;
+	const std::filesystem::path dir =
+	  argc > 2 ? std::filesystem::path(argv[2]) : std::filesystem::temp_directory_path();
+	const auto text   = (dir / "serialize_bench.txt").string();
+	const auto binary = (dir / "serialize_bench.bin").string();
+
+	Matrix<int> mat(n);
+	std::iota(mat.data.get(), mat.data.get() + mat.data.size(), 0);
+	std::cout << "n: " << n << ", " << (mat.size() * sizeof(int) >> 20) << " MiB"
+	          << std::endl;
+
+	double time = measureMs([&] {
+		std::ofstream out(text);
+		out << mat;
+	});
+	std::cout << "text operator<<: " << time << " ms, "
+	          << (std::filesystem::file_size(text) >> 20) << " MiB" << std::endl;
+
+	time = measureMs([&] { save(mat, binary); });
+	std::cout << "binary save: " << time << " ms, "
+	          << (std::filesystem::file_size(binary) >> 20) << " MiB" << std::endl;
+
+	long first = 0, sum = 0;
+	time = measureMs([&] {
+		MappedMatrix<int> mapped(binary);
+		first = mapped.matrix()(0, 0);
+	});
+	std::cout << "mapped open: " << time << " ms" << std::endl;
+	time = measureMs([&] {
+		MappedMatrix<int> mapped(binary);
+		const auto& view = mapped.matrix();
+		sum = std::accumulate(view.data.get(), view.data.get() + view.data.size(), 0L);
+	});
+	std::cout << "mapped open + sum: " << time << " ms (" << first + sum << ")"
+	          << std::endl;
+
+	std::filesystem::remove(text);
+	std::filesystem::remove(binary);
+}
@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <graycode_iterator.hpp>
+#include <hilbert_iterator.hpp>
+#include <matrix.hpp>
+#include <morton_iterator.hpp>
+
+#include "cache_model.hpp"
+#include "measure.hpp"
+
+// Cache behavior of a 5 points stencil (cell + 4 neighbors) applied in
+// row major, Morton, Hilbert and Gray code order.
+// Misses are counted using a set associative LRU cache model, so results do
+// not depend on the host hardware counters.
+// usage: TraversalBench [log2(n)] [cache size (KiB)]
+
+using bench::measure;
+
+//! @brief Apply the stencil on each cell visited by [first, last).
+//! visit(ptr) is called on each accessed element.
+template <typename Iterator, typename Visitor>
+long
+stencil(Matrix<int>& mat, Iterator first, Iterator last, Visitor&& visit) {
+	const int* base = mat.data.get();
+	const long n    = static_cast<long>(mat.n);
+	long sum        = 0;
+	for (; first != last; ++first) {
+		const int* p  = &*first;
+		const long id = p - base;
+		const long x  = id % n;
+		const long y  = id / n;
+		visit(p);
+		sum += *p;
+		if (x > 0) visit(p - 1), sum += p[-1];
+		if (x < n - 1) visit(p + 1), sum += p[1];
+		if (y > 0) visit(p - n), sum += p[-n];
+		if (y < n - 1) visit(p + n), sum += p[n];
+	}
+	return sum;
+}
+
+template <typename Iterator>
+void
+run(const char* name,
+    Matrix<int>& mat,
+    Iterator first,
+    Iterator last,
+    std::size_t cache) {
+	long sum    = 0;
+	double time = measure([&]() { sum = stencil(mat, first, last, [](const int*) {}); });
+	CacheModel model(cache);
+	stencil(mat, first, last, [&model](const int* p) { model.access(p); });
+	std::cout << name << ", " << time / mat.size() << ", "
+	          << double(model.misses()) / mat.size() << " (" << sum << ")" << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t order = argc > 1 ? std::atoi(argv[1]) : 11;
+	const std::size_t cache = (argc > 2 ? std::atoi(argv[2]) : 32) * 1024;
+
+	Matrix<int> mat(std::size_t(1) << order, 1);
+	std::cout << "n: " << mat.n << ", cache model: " << cache / 1024 << " KiB"
+	          << std::endl;
+	std::cout << "traversal, time (ns/cell), misses (per cell)" << std::endl;
+	run("row major", mat, mat.begin(), mat.end(), cache);
+	run("morton",
+	    mat,
+	    morton::iterator<int>(mat).begin(),
+	    morton::iterator<int>(mat).end(),
+	    cache);
+	run("hilbert",
+	    mat,
+	    hilbert::iterator<int>(mat).begin(),
+	    hilbert::iterator<int>(mat).end(),
+	    cache);
+	run("graycode",
+	    mat,
+	    graycode::iterator<int>(mat).begin(),
+	    graycode::iterator<int>(mat).end(),
+	    cache);
+}
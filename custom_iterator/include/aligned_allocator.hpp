@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+//! @class AlignedAllocator allocator returning memory aligned on Align bytes.
+//! Used to get cache line aligned contiguous storage (e.g. Matrix).
+template <typename T, std::size_t Align = 64>
+struct AlignedAllocator {
+	static_assert((Align & (Align - 1)) == 0, "Align must be a power of two.");
+	static_assert(Align >= alignof(T), "Align must be greater than alignof(T).");
+
+	using value_type = T;
+
+	template <typename U>
+	struct rebind {
+		using other = AlignedAllocator<U, Align>;
+	};
+
+	AlignedAllocator() noexcept = default;
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+	T* allocate(std::size_t n) {
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+	}
+	void deallocate(T* p, std::size_t) noexcept {
+		::operator delete(p, std::align_val_t(Align));
+	}
+};
+
+template <typename T, typename U, std::size_t Align>
+bool
+operator==(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) {
+	return true;
+}
+
+template <typename T, typename U, std::size_t Align>
+bool
+operator!=(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) {
+	return false;
+}
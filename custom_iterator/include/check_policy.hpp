@@ -0,0 +1,29 @@
+#pragma once
+
+#include <type_traits>
+
+//! @struct Checked Iterators throw on misuse: dereference out of [begin, end)
+//! (std::range_error), comparison of iterators of different containers
+//! (std::runtime_error).
+struct Checked {
+	static constexpr bool enabled = true;
+};
+
+//! @struct Unchecked Iterators do no check, misuse is undefined behavior.
+//! Traversal loops compile down to the index math only.
+struct Unchecked {
+	static constexpr bool enabled = false;
+};
+
+// Iterators are checked unless NDEBUG is defined (i.e. release builds), define
+// SNIPPETS_CHECKED_ITERATORS to 0 or 1 to override.
+#ifndef SNIPPETS_CHECKED_ITERATORS
+#ifdef NDEBUG
+#define SNIPPETS_CHECKED_ITERATORS 0
+#else
+#define SNIPPETS_CHECKED_ITERATORS 1
+#endif
+#endif
+
+//! Check policy of the iterators when none is given.
+using DefaultCheck = std::conditional_t<SNIPPETS_CHECKED_ITERATORS, Checked, Unchecked>;
@@ -0,0 +1,67 @@
+#pragma once
+
+// x86 backends (BMI2, AVX2, AVX-512) are only compiled on x86-64 with GCC or
+// Clang, and only selected at runtime if the CPU support them.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SNIPPETS_HAS_X86 1
+#define SNIPPETS_TARGET_BMI2 __attribute__((target("bmi2")))
+#define SNIPPETS_TARGET_AVX2 __attribute__((target("avx2")))
+#define SNIPPETS_TARGET_AVX512 __attribute__((target("avx512f")))
+#include <immintrin.h>
+#else
+#define SNIPPETS_HAS_X86 0
+#endif
+
+//! @enum Backend Available implementations of the curve encode/decode.
+enum class Backend {
+	Scalar, //!< One level (i.e. bit pair) per loop iteration.
+	Table,  //!< Four levels (i.e. one byte) per loop iteration using a state table.
+	BMI2,   //!< Table walk on the Morton code computed with pdep/pext.
+	AVX2,   //!< Batch only: 8 x 32 bits lanes (portable backend for a single key).
+	AVX512, //!< Batch only: 16 x 32 bits lanes (portable backend for a single key).
+};
+
+//! @{
+//! @brief Return true if the running CPU support the instruction set.
+inline bool
+hasBMI2() {
+#if SNIPPETS_HAS_X86
+	static const bool res = __builtin_cpu_supports("bmi2");
+	return res;
+#else
+	return false;
+#endif
+}
+
+inline bool
+hasAVX2() {
+#if SNIPPETS_HAS_X86
+	static const bool res = __builtin_cpu_supports("avx2");
+	return res;
+#else
+	return false;
+#endif
+}
+
+inline bool
+hasAVX512() {
+#if SNIPPETS_HAS_X86
+	static const bool res = __builtin_cpu_supports("avx512f");
+	return res;
+#else
+	return false;
+#endif
+}
+//! @}
+
+//! @brief Fastest backend supported by the running CPU for a single key.
+inline Backend
+bestBackend() {
+	return hasBMI2() ? Backend::BMI2 : Backend::Table;
+}
+
+//! @brief Fastest backend supported by the running CPU for a batch of keys.
+inline Backend
+bestBatchBackend() {
+	return hasAVX512() ? Backend::AVX512 : (hasAVX2() ? Backend::AVX2 : bestBackend());
+}
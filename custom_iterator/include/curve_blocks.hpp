@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//! @struct CurveBlocks Rank / select and empty block skipping of a D dimensions
+//! space filling curve walked on a box which is not a power of two cube (e.g. a
+//! rectangle Matrix or a Grid), shared by curve_iterator and
+//! grid_curve_iterator. The 2^(D k) consecutive indices starting at a multiple
+//! of 2^(D k) (a block of level k) must cover an aligned box of cells.
+//! The walked box is a policy (the iterators themselves) whose cell or cursor
+//! types are free:
+//! @code
+//! struct Box {
+//!   Cell decode(std::uint64_t d) const;           // cell of the curve index d
+//!   // cells of the box in the block of level k containing the cell (or cursor)
+//!   std::size_t count(const Cell& cell, unsigned k) const;
+//!   bool inside(const State& state) const;         // cursor cell in the box
+//!   // cursor to the index d after a jump of a level k block
+//!   void move(State& state, std::uint64_t d, unsigned k, bool forward) const;
+//! };
+//! @endcode
+template <std::size_t D>
+struct CurveBlocks {
+	//! @brief Mask of the curve index digits of the levels below k.
+	static std::uint64_t mask(unsigned k);
+
+	//! @brief Curve index of the position pos (i.e. of the pos-th cell of the
+	//! box along the curve of order order), O(order) decodes.
+	template <typename Box>
+	static std::uint64_t select(const Box& box, std::size_t pos, unsigned order);
+
+	//! @{
+	//! @brief Move the cursor (state, index) to the next (or previous) cell of
+	//! the box if it is out of it, skipping the largest empty blocks at once.
+	template <typename Box, typename Index, typename State>
+	static void skipForward(const Box& box, Index& index, State& state, unsigned order);
+	template <typename Box, typename Index, typename State>
+	static void skipBackward(const Box& box, Index& index, State& state, unsigned order);
+	//! @}
+};
+
+#include "details/curve_blocks.hxx"
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "check_policy.hpp"
+#include "curve_blocks.hpp"
+#include "matrix.hpp"
+
+//! @class curve_iterator 2D space filling curve iterator.
+//! The curve is a compile time policy providing the cursor state and the
+//! conversions between curve index and cell:
+//! @code
+//! struct Curve {
+//!   struct State; // cursor on the curve, at least the cell (x, y).
+//!   static void seek(State& s, std::size_t pos, unsigned order);
+//!   static void next(State& s, std::size_t pos, unsigned order); // after ++pos
+//!   static void prev(State& s, std::size_t pos, unsigned order); // after --pos
+//!   static std::uint64_t encode(std::uint32_t x, std::uint32_t y, unsigned order);
+//!   static Vector<std::uint32_t> decode(std::uint64_t d, unsigned order);
+//!   // extents of the aligned box of the cells of 4^k consecutive indices
+//!   // starting at a multiple of 4^k.
+//!   static Vector<std::size_t> block(unsigned k, unsigned order);
+//! };
+//! @endcode
+//! So a new curve only cost its policy (e.g. hilbert::Curve, morton::Curve).
+//! Matrices which are not a power of two square are walked on the curve of the
+//! covering 2^order square, skipping the cells out of the matrix: a whole empty
+//! block is skipped at once, and jumps (+=, []) find the curve index of a
+//! position by counting the cells of the blocks in O(order) decodes.
+//! Layout is the one of the Matrix (i.e. the traversal and storage orders are
+//! independent).
+//! Check is the iterator check policy (Checked or Unchecked), see
+//! check_policy.hpp.
+template <typename T,
+          typename Curve,
+          typename Layout = RowMajor,
+          typename Check  = DefaultCheck>
+class curve_iterator {
+	public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type        = T;
+	using difference_type   = std::ptrdiff_t;
+	using pointer           = T*;
+	using reference         = T&;
+
+	curve_iterator();
+	curve_iterator(Matrix<T, Layout>& mat, std::size_t pos = 0);
+	~curve_iterator();
+
+	curve_iterator begin() const;
+	curve_iterator end() const;
+
+	bool operator==(const curve_iterator& rhs) const;
+	bool operator!=(const curve_iterator& rhs) const;
+	bool operator<(const curve_iterator& rhs) const;
+	bool operator>(const curve_iterator& rhs) const;
+	bool operator<=(const curve_iterator& rhs) const;
+	bool operator>=(const curve_iterator& rhs) const;
+	T& operator*() const;
+	//! @brief Direct decode of the position (i.e. no walk).
+	T& operator[](difference_type n) const;
+	curve_iterator& operator++();   // prefix
+	curve_iterator& operator--();   // prefix
+	curve_iterator operator++(int); // postfix
+	curve_iterator operator--(int); // postfix
+	//! @{
+	//! @brief Jump using a direct decode of the new position (i.e. no walk).
+	curve_iterator& operator+=(difference_type n);
+	curve_iterator& operator-=(difference_type n);
+	curve_iterator operator+(difference_type n) const;
+	curve_iterator operator-(difference_type n) const;
+	friend curve_iterator operator+(difference_type n, const curve_iterator& it) {
+		return it + n;
+	}
+	//! @}
+	difference_type operator-(const curve_iterator& rhs) const;
+
+	//! @{
+	//! @brief Conversions between a cell of the matrix and its curve index
+	//! (i.e. the traversal position for power of two squares only).
+	std::size_t XYToBinary(Vector<std::size_t> vec) const;
+	Vector<std::size_t> BinaryToXY(std::size_t d) const;
+	//! @}
+
+	private:
+	//! @brief Move the cursor to the cell of the position _pos.
+	void seek();
+	//! @brief Curve index of the position pos (i.e. of the pos-th cell of the
+	//! matrix along the curve).
+	std::size_t select(std::size_t pos) const;
+
+	//! @{
+	//! @brief Box policy of CurveBlocks<2> (the matrix cells).
+	template <std::size_t>
+	friend struct CurveBlocks;
+	Vector<std::uint32_t> decode(std::uint64_t d) const;
+	//! @brief Number of cells of the matrix in the block of 4^k indices
+	//! containing the cell (xy.x, xy.y) (a Vector or a Curve::State).
+	template <typename XY>
+	std::size_t count(const XY& xy, unsigned k) const;
+	bool inside(const typename Curve::State& state) const;
+	void move(typename Curve::State& state,
+	          std::uint64_t d,
+	          unsigned k,
+	          bool forward) const;
+	//! @}
+
+	Matrix<T, Layout>* _mat;
+	std::size_t _pos;   // traversal position in [0, width * height]
+	std::size_t _index; // curve index of _pos
+	unsigned _order;    // log2(n)
+	typename Curve::State _state;
+};
+
+#include "details/curve_iterator.hxx"
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "matrix.hpp"
+
+//! @struct CurveRange Closed interval [first, last] of curve indices (closed so
+//! the whole curve of order 32 is representable).
+struct CurveRange {
+	std::uint64_t first;
+	std::uint64_t last;
+};
+
+//! @brief Sorted curve index intervals covering the cells of the rectangle
+//! [min.x, max.x] x [min.y, max.y] of the 2^order square, for a curve policy
+//! of curve_iterator (e.g. hilbert::Curve, morton::Curve, graycode::Curve).
+//! The curve blocks are descended from the whole square: a block out of the
+//! rectangle is pruned, a block inside it is one interval, the others are
+//! split in their 4 sub blocks. Adjacent intervals are merged, so the result
+//! is the minimal exact cover.
+//! If maxRanges is not 0 the descent is budgeted: the blocks are split level
+//! by level (coarsest first) while there are at most maxRanges intervals, a
+//! block which can not be split is covered whole. So at most maxRanges
+//! intervals cover the rectangle and some other cells (to be filtered by the
+//! caller), in O(order * maxRanges) decodes whatever the rectangle size. The
+//! first and last intervals still start and end on cells of the rectangle.
+//! Throw std::range_error if the rectangle is empty or out of the square.
+template <typename Curve>
+std::vector<CurveRange> curve_ranges(Vector<std::uint32_t> min,
+                                     Vector<std::uint32_t> max,
+                                     unsigned order,
+                                     std::size_t maxRanges = 0);
+
+#include "details/curve_ranges.hxx"
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <curve_blocks.hpp>
+
+template <std::size_t D>
+std::uint64_t
+CurveBlocks<D>::mask(unsigned k) {
+	return D * k >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << (D * k)) - 1;
+}
+
+template <std::size_t D>
+template <typename Box>
+std::uint64_t
+CurveBlocks<D>::select(const Box& box, std::size_t pos, unsigned order) {
+	// From the top level, skip the blocks with less than pos cells.
+	std::uint64_t res = 0;
+	for (unsigned k = order; k-- > 0;) {
+		for (std::uint64_t j = 0; j < (std::uint64_t(1) << D); ++j) {
+			const std::uint64_t d = res + (j << (D * k));
+			const std::size_t c   = box.count(box.decode(d), k);
+			if (pos < c) {
+				res = d;
+				break;
+			}
+			pos -= c;
+		}
+	}
+	return res;
+}
+
+template <std::size_t D>
+template <typename Box, typename Index, typename State>
+void
+CurveBlocks<D>::skipForward(const Box& box,
+                             Index& index,
+                             State& state,
+                             unsigned order) {
+	while (!box.inside(state)) {
+		// Largest empty block starting at index.
+		unsigned k = 0;
+		while (k < order && (index & mask(k + 1)) == 0 &&
+		       box.count(state, k + 1) == 0)
+			++k;
+		index += static_cast<Index>(mask(k) + 1);
+		box.move(state, index, k, true);
+	}
+}
+
+template <std::size_t D>
+template <typename Box, typename Index, typename State>
+void
+CurveBlocks<D>::skipBackward(const Box& box,
+                              Index& index,
+                              State& state,
+                              unsigned order) {
+	while (!box.inside(state)) {
+		// Largest empty block ending at index.
+		unsigned k = 0;
+		while (k < order && ((index + 1) & mask(k + 1)) == 0 &&
+		       box.count(state, k + 1) == 0)
+			++k;
+		index -= static_cast<Index>(mask(k) + 1);
+		box.move(state, index, k, false);
+	}
+}
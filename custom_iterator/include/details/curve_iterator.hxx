@@ -0,0 +1,252 @@
+#pragma once
+
+#include <curve_iterator.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>::curve_iterator()
+  : _mat(nullptr)
+  , _pos(0)
+  , _index(0)
+  , _order(0)
+  , _state() {}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>::curve_iterator(Matrix<T, Layout>& mat,
+                                                        std::size_t pos)
+  : _mat(&mat)
+  , _pos(pos)
+  , _index(0)
+  , _order(mat.order)
+  , _state() {
+	// std::cout << "curve_iterator::curve_iterator() called\n";
+	if (_pos < _mat->size()) seek();
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>::~curve_iterator() {
+	// std::cout << "curve_iterator::~curve_iterator() called\n";
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>
+curve_iterator<T, Curve, Layout, Check>::begin() const {
+	return curve_iterator(*_mat);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>
+curve_iterator<T, Curve, Layout, Check>::end() const {
+	return curve_iterator(*_mat, _mat->size());
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+bool
+curve_iterator<T, Curve, Layout, Check>::operator==(const curve_iterator& rhs) const {
+	if constexpr (Check::enabled) {
+		if (_mat != rhs._mat)
+			throw std::runtime_error("iterator not on the same container");
+	}
+	return _pos == rhs._pos;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+bool
+curve_iterator<T, Curve, Layout, Check>::operator!=(const curve_iterator& rhs) const {
+	return !(*this == rhs);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+bool
+curve_iterator<T, Curve, Layout, Check>::operator<(const curve_iterator& rhs) const {
+	return _pos < rhs._pos;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+bool
+curve_iterator<T, Curve, Layout, Check>::operator>(const curve_iterator& rhs) const {
+	return rhs < *this;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+bool
+curve_iterator<T, Curve, Layout, Check>::operator<=(const curve_iterator& rhs) const {
+	return !(rhs < *this);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+bool
+curve_iterator<T, Curve, Layout, Check>::operator>=(const curve_iterator& rhs) const {
+	return !(*this < rhs);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+T& curve_iterator<T, Curve, Layout, Check>::operator*() const {
+	if constexpr (Check::enabled) {
+		if (_pos > _mat->size() - 1)
+			throw std::range_error("Distance must be in range [0, n^2-1]");
+	}
+	return (*_mat)(_state.x, _state.y); // x, y are already up to date
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+T& curve_iterator<T, Curve, Layout, Check>::operator[](difference_type n) const {
+	if constexpr (Check::enabled) {
+		if (_pos + n > _mat->size() - 1)
+			throw std::range_error("Distance must be in range [0, n^2-1]");
+	}
+	auto res = Curve::decode(select(_pos + n), _order);
+	return (*_mat)(res.x, res.y);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>&
+curve_iterator<T, Curve, Layout, Check>::operator++() { // prefix
+	if (++_pos < _mat->size()) {
+		Curve::next(_state, ++_index, _order);
+		CurveBlocks<2>::skipForward(*this, _index, _state, _order);
+	}
+	return *this;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>
+curve_iterator<T, Curve, Layout, Check>::operator++(int) { // postfix
+	curve_iterator res(*this);
+	++(*this);
+	return res;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>&
+curve_iterator<T, Curve, Layout, Check>::operator--() { // prefix
+	if (_pos-- == _mat->size()) {
+		seek(); // from end()
+	} else if (_pos < _mat->size()) {
+		Curve::prev(_state, --_index, _order);
+		CurveBlocks<2>::skipBackward(*this, _index, _state, _order);
+	}
+	return *this;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>
+curve_iterator<T, Curve, Layout, Check>::operator--(int) { // postfix
+	curve_iterator res(*this);
+	--(*this);
+	return res;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>&
+curve_iterator<T, Curve, Layout, Check>::operator+=(difference_type n) {
+	_pos += n;
+	if (_pos < _mat->size()) seek();
+	return *this;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>&
+curve_iterator<T, Curve, Layout, Check>::operator-=(difference_type n) {
+	return *this += -n;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>
+curve_iterator<T, Curve, Layout, Check>::operator+(difference_type n) const {
+	return curve_iterator(*this) += n;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+curve_iterator<T, Curve, Layout, Check>
+curve_iterator<T, Curve, Layout, Check>::operator-(difference_type n) const {
+	return curve_iterator(*this) -= n;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+typename curve_iterator<T, Curve, Layout, Check>::difference_type
+curve_iterator<T, Curve, Layout, Check>::operator-(const curve_iterator& rhs) const {
+	return static_cast<difference_type>(_pos) - static_cast<difference_type>(rhs._pos);
+}
+
+//////////////////
+//  CONVERTION  //
+//////////////////
+
+template <typename T, typename Curve, typename Layout, typename Check>
+std::size_t
+curve_iterator<T, Curve, Layout, Check>::XYToBinary(Vector<std::size_t> vec) const {
+	if (vec.x < 0 || vec.x >= _mat->width || vec.y < 0 || vec.y >= _mat->height)
+		throw std::runtime_error("X,Y must be in [0;width-1]x[0;height-1]");
+
+	return Curve::encode(vec.x, vec.y, _order);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+Vector<std::size_t>
+curve_iterator<T, Curve, Layout, Check>::BinaryToXY(std::size_t d) const {
+	if (d < 0 || d > (std::size_t(1) << (2 * _order)) - 1)
+		throw std::range_error("Distance must be in range [0, 4^order-1]");
+
+	auto res = Curve::decode(d, _order);
+	return Vector<std::size_t>(res.x, res.y);
+}
+
+////////////////
+//  Skipping  //
+////////////////
+
+template <typename T, typename Curve, typename Layout, typename Check>
+void
+curve_iterator<T, Curve, Layout, Check>::seek() {
+	_index = select(_pos);
+	Curve::seek(_state, _index, _order);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+std::size_t
+curve_iterator<T, Curve, Layout, Check>::select(std::size_t pos) const {
+	if (_mat->size() == std::size_t(1) << (2 * _order)) return pos; // no hole
+	return static_cast<std::size_t>(CurveBlocks<2>::select(*this, pos, _order));
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+Vector<std::uint32_t>
+curve_iterator<T, Curve, Layout, Check>::decode(std::uint64_t d) const {
+	return Curve::decode(d, _order);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+template <typename XY>
+std::size_t
+curve_iterator<T, Curve, Layout, Check>::count(const XY& xy, unsigned k) const {
+	const auto ext       = Curve::block(k, _order);
+	const std::size_t x0 = xy.x & ~(ext.x - 1);
+	const std::size_t y0 = xy.y & ~(ext.y - 1);
+	if (x0 >= _mat->width || y0 >= _mat->height) return 0;
+	return (std::min(x0 + ext.x, _mat->width) - x0) *
+	       (std::min(y0 + ext.y, _mat->height) - y0);
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+bool
+curve_iterator<T, Curve, Layout, Check>::inside(
+  const typename Curve::State& state) const {
+	return state.x < _mat->width && state.y < _mat->height;
+}
+
+template <typename T, typename Curve, typename Layout, typename Check>
+void
+curve_iterator<T, Curve, Layout, Check>::move(typename Curve::State& state,
+                                              std::uint64_t d,
+                                              unsigned k,
+                                              bool forward) const {
+	if (k != 0)
+		Curve::seek(state, d, _order);
+	else if (forward)
+		Curve::next(state, d, _order);
+	else
+		Curve::prev(state, d, _order);
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <curve_ranges.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace details {
+
+//! @enum Overlap Position of a curve block relative to the rectangle.
+enum class Overlap { Disjoint, Partial, Inside };
+
+//! @brief Position of the block of 4^k indices starting at d.
+template <typename Curve>
+Overlap
+overlap(std::uint64_t d,
+        unsigned k,
+        const Vector<std::uint32_t>& min,
+        const Vector<std::uint32_t>& max,
+        unsigned order) {
+	const auto ext         = Curve::block(k, order);
+	const auto xy          = Curve::decode(d, order);
+	const std::uint64_t x0 = xy.x & ~(ext.x - 1);
+	const std::uint64_t y0 = xy.y & ~(ext.y - 1);
+	const std::uint64_t x1 = x0 + ext.x - 1;
+	const std::uint64_t y1 = y0 + ext.y - 1;
+	if (x0 > max.x || x1 < min.x || y0 > max.y || y1 < min.y) return Overlap::Disjoint;
+	if (x0 >= min.x && x1 <= max.x && y0 >= min.y && y1 <= max.y) return Overlap::Inside;
+	return Overlap::Partial;
+}
+
+//! @brief Last index of the block of 4^k indices starting at d.
+inline std::uint64_t
+blockLast(std::uint64_t d, unsigned k) {
+	const std::uint64_t size = 2 * k < 64 ? std::uint64_t(1) << (2 * k) : 0;
+	return d + (size - 1); // the whole curve if k = 32
+}
+
+//! @brief Append [first, last] to the sorted intervals res (merged if adjacent).
+inline void
+appendRange(std::uint64_t first, std::uint64_t last, std::vector<CurveRange>& res) {
+	if (!res.empty() && res.back().last + 1 == first)
+		res.back().last = last;
+	else
+		res.push_back({first, last});
+}
+
+//! @brief Append the intervals of the block of 4^k indices starting at d.
+template <typename Curve>
+void
+appendRanges(std::uint64_t d,
+             unsigned k,
+             const Vector<std::uint32_t>& min,
+             const Vector<std::uint32_t>& max,
+             unsigned order,
+             std::vector<CurveRange>& res) {
+	switch (overlap<Curve>(d, k, min, max, order)) {
+		case Overlap::Disjoint:
+			return;
+		case Overlap::Inside:
+			appendRange(d, blockLast(d, k), res);
+			return;
+		case Overlap::Partial:
+			break;
+	}
+	const std::uint64_t step = std::uint64_t(1) << (2 * (k - 1));
+	for (std::uint64_t j = 0; j < 4; ++j)
+		appendRanges<Curve>(d + j * step, k - 1, min, max, order, res);
+}
+
+//! @brief First (or last if fromEnd) index of a cell of the rectangle in the
+//! partial block of 4^k indices starting at d, O(k) decodes.
+template <typename Curve>
+std::uint64_t
+coveredEnd(std::uint64_t d,
+           unsigned k,
+           const Vector<std::uint32_t>& min,
+           const Vector<std::uint32_t>& max,
+           unsigned order,
+           bool fromEnd) {
+	for (; k > 0; --k) {
+		const std::uint64_t step = std::uint64_t(1) << (2 * (k - 1));
+		for (std::uint64_t j = 0; j < 4; ++j) {
+			const std::uint64_t child = d + (fromEnd ? 3 - j : j) * step;
+			const Overlap o           = overlap<Curve>(child, k - 1, min, max, order);
+			if (o == Overlap::Disjoint) continue;
+			if (o == Overlap::Inside) return fromEnd ? blockLast(child, k - 1) : child;
+			d = child;
+			break;
+		}
+	}
+	return d;
+}
+
+//! @struct CurveBlock Indices [first, last] of a block of 4^k indices (or of
+//! adjacent blocks inside the rectangle), partial if some of its cells are out
+//! of the rectangle.
+struct CurveBlock {
+	std::uint64_t first;
+	std::uint64_t last;
+	unsigned k;
+	bool partial;
+};
+
+//! @brief Append b to the sorted blocks res, merged with the previous one if
+//! both are inside the rectangle and adjacent.
+inline void
+appendBlock(const CurveBlock& b, std::vector<CurveBlock>& res) {
+	if (!b.partial && !res.empty() && !res.back().partial &&
+	    res.back().last + 1 == b.first)
+		res.back().last = b.last;
+	else
+		res.push_back(b);
+}
+
+//! @brief Append at most maxRanges intervals covering the rectangle: the
+//! partial blocks are split level by level (coarsest first) while the number
+//! of intervals stays within maxRanges, a block which can not be split is
+//! covered whole. O(order * maxRanges) decodes whatever the rectangle.
+template <typename Curve>
+void
+appendBoundedRanges(const Vector<std::uint32_t>& min,
+                    const Vector<std::uint32_t>& max,
+                    unsigned order,
+                    std::size_t maxRanges,
+                    std::vector<CurveRange>& res) {
+	// Kept blocks (adjacent inside blocks merged) are bounded too.
+	const std::size_t maxBlocks =
+	  maxRanges < std::size_t(-1) / 4 ? 4 * maxRanges : std::size_t(-1);
+	const bool partial = overlap<Curve>(0, order, min, max, order) == Overlap::Partial;
+	std::vector<CurveBlock> blocks{{0, blockLast(0, order), order, partial}}, next;
+	std::size_t count = 1; // intervals, i.e. blocks not adjacent to the previous one
+	for (unsigned k = order; k > 0; --k) {
+		const std::uint64_t step = std::uint64_t(1) << (2 * (k - 1));
+		bool split               = false;
+		next.clear();
+		for (std::size_t i = 0; i < blocks.size(); ++i) {
+			const CurveBlock& b = blocks[i];
+			if (!b.partial || b.k != k) { // inside, or left whole at a coarser level
+				appendBlock(b, next);
+				continue;
+			}
+			CurveBlock children[4];
+			std::size_t n = 0;
+			for (std::uint64_t j = 0; j < 4; ++j) {
+				const std::uint64_t d = b.first + j * step;
+				const Overlap o       = overlap<Curve>(d, k - 1, min, max, order);
+				if (o != Overlap::Disjoint)
+					children[n++] = {d, d + step - 1, k - 1, o == Overlap::Partial};
+			}
+			// Gaps (i.e. interval starts) around b before and after the split.
+			const CurveBlock* prev = next.empty() ? nullptr : &next.back();
+			const CurveBlock* succ = i + 1 < blocks.size() ? &blocks[i + 1] : nullptr;
+			auto gap = [](const CurveBlock* lhs, const CurveBlock* rhs) -> std::size_t {
+				return lhs && rhs && lhs->last + 1 != rhs->first ? 1 : 0;
+			};
+			std::size_t before = gap(prev, &b) + gap(&b, succ);
+			std::size_t after  = gap(prev, &children[0]) + gap(&children[n - 1], succ);
+			for (std::size_t c = 1; c < n; ++c)
+				after += gap(&children[c - 1], &children[c]);
+			if (count + after - before <= maxRanges &&
+			    next.size() + (blocks.size() - i - 1) + n <= maxBlocks) {
+				for (std::size_t c = 0; c < n; ++c)
+					appendBlock(children[c], next);
+				count += after - before;
+				split = true;
+			} else {
+				appendBlock(b, next);
+			}
+		}
+		blocks.swap(next);
+		if (!split) break;
+	}
+
+	// The first and last partial blocks start and end on a cell of the rectangle
+	// (no other interval bound moves, so the count is unchanged).
+	CurveBlock& front = blocks.front();
+	if (front.partial)
+		front.first = coveredEnd<Curve>(front.first, front.k, min, max, order, false);
+	CurveBlock& back = blocks.back();
+	if (back.partial)
+		back.last = coveredEnd<Curve>(back.first, back.k, min, max, order, true);
+	for (const auto& b : blocks)
+		appendRange(b.first, b.last, res);
+}
+} // namespace details
+
+template <typename Curve>
+std::vector<CurveRange>
+curve_ranges(Vector<std::uint32_t> min,
+             Vector<std::uint32_t> max,
+             unsigned order,
+             std::size_t maxRanges) {
+	if (order > 32)
+		throw std::range_error("Rectangle must be in [0, 2^order-1]^2 and not empty");
+	const std::uint64_t side = std::uint64_t(1) << order;
+	if (min.x > max.x || min.y > max.y || max.x >= side || max.y >= side)
+		throw std::range_error("Rectangle must be in [0, 2^order-1]^2 and not empty");
+
+	std::vector<CurveRange> res;
+	if (maxRanges == 0)
+		details::appendRanges<Curve>(0, order, min, max, order, res);
+	else
+		details::appendBoundedRanges<Curve>(min, max, order, maxRanges, res);
+	return res;
+}
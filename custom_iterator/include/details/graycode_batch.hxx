@@ -0,0 +1,179 @@
+#pragma once
+
+#include <graycode_codec.hpp>
+
+namespace graycode {
+namespace details {
+
+// Gray code encoding and the log-step prefix XOR only need 64 bits shifts, so
+// each key is processed in a 64 bits lane.
+
+#if SNIPPETS_HAS_X86
+////////////
+//  AVX2  //
+////////////
+
+SNIPPETS_TARGET_AVX2 inline void
+encodeAVX2(const std::uint32_t* xs,
+           const std::uint32_t* ys,
+           std::uint64_t* out,
+           std::size_t count,
+           unsigned order) {
+	const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(order));
+	std::size_t i       = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m256i x = _mm256_cvtepu32_epi64(
+		  _mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i)));
+		const __m256i y = _mm256_cvtepu32_epi64(
+		  _mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i)));
+		const __m256i d = _mm256_or_si256(_mm256_sll_epi64(y, shift), x);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+		                    _mm256_xor_si256(d, _mm256_srli_epi64(d, 1)));
+	}
+	for (; i < count; ++i)
+		out[i] = encode(xs[i], ys[i], order);
+}
+
+SNIPPETS_TARGET_AVX2 inline void
+decodeAVX2(const std::uint64_t* ds,
+           std::uint32_t* xs,
+           std::uint32_t* ys,
+           std::size_t count,
+           unsigned order) {
+	const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(order));
+	const __m256i mask  = _mm256_set1_epi64x((std::int64_t(1) << order) - 1);
+	// Keep the low 32 bits of each 64 bits lane.
+	const __m256i narrow = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+	std::size_t i        = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ds + i));
+		d         = _mm256_xor_si256(d, _mm256_srli_epi64(d, 32));
+		d         = _mm256_xor_si256(d, _mm256_srli_epi64(d, 16));
+		d         = _mm256_xor_si256(d, _mm256_srli_epi64(d, 8));
+		d         = _mm256_xor_si256(d, _mm256_srli_epi64(d, 4));
+		d         = _mm256_xor_si256(d, _mm256_srli_epi64(d, 2));
+		d         = _mm256_xor_si256(d, _mm256_srli_epi64(d, 1));
+		const __m256i x =
+		  _mm256_permutevar8x32_epi32(_mm256_and_si256(d, mask), narrow);
+		const __m256i y =
+		  _mm256_permutevar8x32_epi32(_mm256_srl_epi64(d, shift), narrow);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(xs + i), _mm256_castsi256_si128(x));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(ys + i), _mm256_castsi256_si128(y));
+	}
+	for (; i < count; ++i) {
+		auto xy = decodeScalar(ds[i], order);
+		xs[i]   = xy.x;
+		ys[i]   = xy.y;
+	}
+}
+
+//////////////
+//  AVX512  //
+//////////////
+
+SNIPPETS_TARGET_AVX512 inline void
+encodeAVX512(const std::uint32_t* xs,
+             const std::uint32_t* ys,
+             std::uint64_t* out,
+             std::size_t count,
+             unsigned order) {
+	const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(order));
+	std::size_t i       = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m512i x = _mm512_cvtepu32_epi64(
+		  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i)));
+		const __m512i y = _mm512_cvtepu32_epi64(
+		  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i)));
+		const __m512i d = _mm512_or_si512(_mm512_sll_epi64(y, shift), x);
+		_mm512_storeu_si512(out + i, _mm512_xor_si512(d, _mm512_srli_epi64(d, 1)));
+	}
+	for (; i < count; ++i)
+		out[i] = encode(xs[i], ys[i], order);
+}
+
+SNIPPETS_TARGET_AVX512 inline void
+decodeAVX512(const std::uint64_t* ds,
+             std::uint32_t* xs,
+             std::uint32_t* ys,
+             std::size_t count,
+             unsigned order) {
+	const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(order));
+	const __m512i mask  = _mm512_set1_epi64((std::int64_t(1) << order) - 1);
+	std::size_t i       = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m512i d = _mm512_loadu_si512(ds + i);
+		d         = _mm512_xor_si512(d, _mm512_srli_epi64(d, 32));
+		d         = _mm512_xor_si512(d, _mm512_srli_epi64(d, 16));
+		d         = _mm512_xor_si512(d, _mm512_srli_epi64(d, 8));
+		d         = _mm512_xor_si512(d, _mm512_srli_epi64(d, 4));
+		d         = _mm512_xor_si512(d, _mm512_srli_epi64(d, 2));
+		d         = _mm512_xor_si512(d, _mm512_srli_epi64(d, 1));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(xs + i),
+		                    _mm512_cvtepi64_epi32(_mm512_and_si512(d, mask)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(ys + i),
+		                    _mm512_cvtepi64_epi32(_mm512_srl_epi64(d, shift)));
+	}
+	for (; i < count; ++i) {
+		auto xy = decodeScalar(ds[i], order);
+		xs[i]   = xy.x;
+		ys[i]   = xy.y;
+	}
+}
+#endif
+} // namespace details
+
+inline void
+encodeBatch(Backend backend,
+            const std::uint32_t* xs,
+            const std::uint32_t* ys,
+            std::uint64_t* out,
+            std::size_t count,
+            unsigned order) {
+#if SNIPPETS_HAS_X86
+	if (backend == Backend::AVX2) return details::encodeAVX2(xs, ys, out, count, order);
+	if (backend == Backend::AVX512)
+		return details::encodeAVX512(xs, ys, out, count, order);
+#endif
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = encode(backend, xs[i], ys[i], order);
+}
+
+inline void
+decodeBatch(Backend backend,
+            const std::uint64_t* ds,
+            std::uint32_t* xs,
+            std::uint32_t* ys,
+            std::size_t count,
+            unsigned order) {
+#if SNIPPETS_HAS_X86
+	if (backend == Backend::AVX2) return details::decodeAVX2(ds, xs, ys, count, order);
+	if (backend == Backend::AVX512)
+		return details::decodeAVX512(ds, xs, ys, count, order);
+#endif
+	for (std::size_t i = 0; i < count; ++i) {
+		auto xy = decode(backend, ds[i], order);
+		xs[i]   = xy.x;
+		ys[i]   = xy.y;
+	}
+}
+
+inline void
+encodeBatch(const std::uint32_t* xs,
+            const std::uint32_t* ys,
+            std::uint64_t* out,
+            std::size_t count,
+            unsigned order) {
+	static const Backend backend = bestBatchBackend();
+	encodeBatch(backend, xs, ys, out, count, order);
+}
+
+inline void
+decodeBatch(const std::uint64_t* ds,
+            std::uint32_t* xs,
+            std::uint32_t* ys,
+            std::size_t count,
+            unsigned order) {
+	static const Backend backend = bestBatchBackend();
+	decodeBatch(backend, ds, xs, ys, count, order);
+}
+} // namespace graycode
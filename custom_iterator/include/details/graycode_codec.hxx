@@ -0,0 +1,90 @@
+#pragma once
+
+#include <graycode_codec.hpp>
+
+namespace graycode {
+namespace details {
+
+//! @brief Prefix XOR (i.e. Gray code decoding) of each byte value.
+struct Table {
+	std::uint8_t decode[256];
+};
+
+constexpr Table
+makeTable() {
+	Table table{};
+	for (unsigned i = 0; i < 256; ++i) {
+		unsigned d = i;
+		d ^= d >> 4;
+		d ^= d >> 2;
+		d ^= d >> 1;
+		table.decode[i] = static_cast<std::uint8_t>(d);
+	}
+	return table;
+}
+
+inline constexpr Table kTable = makeTable();
+
+inline Vector<std::uint32_t>
+split(std::uint64_t d, unsigned order) {
+	const std::uint64_t mask = (std::uint64_t(1) << order) - 1;
+	return Vector<std::uint32_t>(static_cast<std::uint32_t>(d & mask),
+	                             static_cast<std::uint32_t>(d >> order));
+}
+
+inline Vector<std::uint32_t>
+decodeScalar(std::uint64_t d, unsigned order) {
+	d = d ^ (d >> 32);
+	d = d ^ (d >> 16);
+	d = d ^ (d >> 8);
+	d = d ^ (d >> 4);
+	d = d ^ (d >> 2);
+	d = d ^ (d >> 1);
+	return split(d, order);
+}
+
+inline Vector<std::uint32_t>
+decodeTable(std::uint64_t d, unsigned order) {
+	// From the most significant byte, the parity of the upper bytes complement
+	// the byte decoding.
+	std::uint64_t res = 0;
+	unsigned parity   = 0;
+	for (int g = 7; g >= 0; --g) {
+		const unsigned b = kTable.decode[(d >> (8 * g)) & 0xFF] ^ (parity ? 0xFF : 0);
+		res              = (res << 8) | b;
+		parity           = b & 1;
+	}
+	return split(res, order);
+}
+} // namespace details
+
+inline std::uint64_t
+encode(Backend, std::uint32_t x, std::uint32_t y, unsigned order) {
+	return encode(x, y, order);
+}
+
+inline Vector<std::uint32_t>
+decode(Backend backend, std::uint64_t d, unsigned order) {
+	switch (backend) {
+		case Backend::Table:
+			return details::decodeTable(d, order);
+		case Backend::Scalar:
+		case Backend::BMI2:
+		case Backend::AVX2:
+		case Backend::AVX512:
+			return details::decodeScalar(d, order);
+	}
+	return details::decodeScalar(d, order);
+}
+
+inline std::uint64_t
+encode(std::uint32_t x, std::uint32_t y, unsigned order) {
+	const std::uint64_t d = (std::uint64_t(y) << order) | x;
+	return d ^ (d >> 1);
+}
+
+inline Vector<std::uint32_t>
+decode(std::uint64_t d, unsigned order) {
+	return details::decodeScalar(d, order);
+}
+} // namespace graycode
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <grid.hpp>
+
+#include <stdexcept>
+
+template <typename T, std::size_t D>
+Grid<T, D>::Grid(std::size_t n, const T& value)
+  : Grid(cube(n), value) {}
+
+template <typename T, std::size_t D>
+Grid<T, D>::Grid(const Point& extents, const T& value)
+  : extents(extents)
+  , n(max(extents))
+  , order(log2(n))
+  , _strides()
+  , _values() {
+	std::size_t stride = 1;
+	for (std::size_t i = 0; i < D; ++i) {
+		_strides[i] = stride;
+		stride *= extents[i];
+	}
+	_values.assign(stride, value);
+}
+
+template <typename T, std::size_t D>
+unsigned
+Grid<T, D>::log2(std::size_t n) {
+	if (n == 0) throw std::runtime_error("Extents must be positive.");
+	unsigned res = 0;
+	while ((std::size_t(1) << res) < n) ++res;
+	if (D * res > 64)
+		throw std::range_error("Curve indices must fit in 64 bits (D * order <= 64)");
+	return res;
+}
+
+template <typename T, std::size_t D>
+std::size_t
+Grid<T, D>::max(const Point& extents) {
+	std::size_t res = 0;
+	for (std::size_t i = 0; i < D; ++i) {
+		if (extents[i] == 0) return 0;
+		if (extents[i] > res) res = extents[i];
+	}
+	return res;
+}
+
+template <typename T, std::size_t D>
+typename Grid<T, D>::Point
+Grid<T, D>::cube(std::size_t n) {
+	Point res;
+	res.fill(n);
+	return res;
+}
+
+template <typename T, std::size_t D>
+std::size_t
+Grid<T, D>::size() const {
+	return _values.size();
+}
+
+template <typename T, std::size_t D>
+std::size_t
+Grid<T, D>::offset(const Point& p) const {
+	std::size_t res = 0;
+	for (std::size_t i = 0; i < D; ++i)
+		res += p[i] * _strides[i];
+	return res;
+}
+
+template <typename T, std::size_t D>
+T&
+Grid<T, D>::operator()(const Point& p) {
+	return _values[offset(p)];
+}
+
+template <typename T, std::size_t D>
+const T&
+Grid<T, D>::operator()(const Point& p) const {
+	return _values[offset(p)];
+}
+
+template <typename T, std::size_t D>
+T& Grid<T, D>::operator[](std::size_t pos) {
+	return _values[pos];
+}
+
+template <typename T, std::size_t D>
+const T& Grid<T, D>::operator[](std::size_t pos) const {
+	return _values[pos];
+}
+
+template <typename T, std::size_t D>
+T*
+Grid<T, D>::begin() {
+	return _values.data();
+}
+
+template <typename T, std::size_t D>
+T*
+Grid<T, D>::end() {
+	return _values.data() + _values.size();
+}
+
+template <typename T, std::size_t D>
+const T*
+Grid<T, D>::begin() const {
+	return _values.data();
+}
+
+template <typename T, std::size_t D>
+const T*
+Grid<T, D>::end() const {
+	return _values.data() + _values.size();
+}
+
+template <typename T, std::size_t D>
+T*
+Grid<T, D>::get() {
+	return _values.data();
+}
+
+template <typename T, std::size_t D>
+const T*
+Grid<T, D>::get() const {
+	return _values.data();
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <grid_iterator.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>::grid_curve_iterator()
+  : _grid(nullptr)
+  , _pos(0)
+  , _index(0)
+  , _order(0)
+  , _full(true)
+  , _cell() {}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>::grid_curve_iterator(Grid<T, D>& grid,
+                                                             std::size_t pos)
+  : _grid(&grid)
+  , _pos(pos)
+  , _index(0)
+  , _order(grid.order)
+  , _full(true)
+  , _cell() {
+	for (std::size_t i = 0; i < D; ++i)
+		_full = _full && grid.extents[i] == (std::size_t(1) << _order);
+	if (_pos < _grid->size()) seek();
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>
+grid_curve_iterator<T, D, Curve, Check>::begin() const {
+	return grid_curve_iterator(*_grid);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>
+grid_curve_iterator<T, D, Curve, Check>::end() const {
+	return grid_curve_iterator(*_grid, _grid->size());
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+bool
+grid_curve_iterator<T, D, Curve, Check>::operator==(
+  const grid_curve_iterator& rhs) const {
+	if constexpr (Check::enabled) {
+		if (_grid != rhs._grid)
+			throw std::runtime_error("iterator not on the same container");
+	}
+	return _pos == rhs._pos;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+bool
+grid_curve_iterator<T, D, Curve, Check>::operator!=(
+  const grid_curve_iterator& rhs) const {
+	return !(*this == rhs);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+bool
+grid_curve_iterator<T, D, Curve, Check>::operator<(
+  const grid_curve_iterator& rhs) const {
+	return _pos < rhs._pos;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+bool
+grid_curve_iterator<T, D, Curve, Check>::operator>(
+  const grid_curve_iterator& rhs) const {
+	return rhs < *this;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+bool
+grid_curve_iterator<T, D, Curve, Check>::operator<=(
+  const grid_curve_iterator& rhs) const {
+	return !(rhs < *this);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+bool
+grid_curve_iterator<T, D, Curve, Check>::operator>=(
+  const grid_curve_iterator& rhs) const {
+	return !(*this < rhs);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+T& grid_curve_iterator<T, D, Curve, Check>::operator*() const {
+	if constexpr (Check::enabled) {
+		if (_pos >= _grid->size())
+			throw std::range_error("Distance must be in range [0, size-1]");
+	}
+	return (*_grid)(point());
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+T& grid_curve_iterator<T, D, Curve, Check>::operator[](difference_type n) const {
+	if constexpr (Check::enabled) {
+		if (_pos + n >= _grid->size())
+			throw std::range_error("Distance must be in range [0, size-1]");
+	}
+	return (*_grid)(BinaryToPoint(select(_pos + n)));
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>&
+grid_curve_iterator<T, D, Curve, Check>::operator++() { // prefix
+	if (++_pos < _grid->size()) {
+		_cell = Curve::decode(++_index, _order);
+		CurveBlocks<D>::skipForward(*this, _index, _cell, _order);
+	}
+	return *this;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>
+grid_curve_iterator<T, D, Curve, Check>::operator++(int) { // postfix
+	grid_curve_iterator res(*this);
+	++(*this);
+	return res;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>&
+grid_curve_iterator<T, D, Curve, Check>::operator--() { // prefix
+	if (_pos-- == _grid->size()) {
+		seek(); // from end()
+	} else if (_pos < _grid->size()) {
+		_cell = Curve::decode(--_index, _order);
+		CurveBlocks<D>::skipBackward(*this, _index, _cell, _order);
+	}
+	return *this;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>
+grid_curve_iterator<T, D, Curve, Check>::operator--(int) { // postfix
+	grid_curve_iterator res(*this);
+	--(*this);
+	return res;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>&
+grid_curve_iterator<T, D, Curve, Check>::operator+=(difference_type n) {
+	_pos += n;
+	if (_pos < _grid->size()) seek();
+	return *this;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>&
+grid_curve_iterator<T, D, Curve, Check>::operator-=(difference_type n) {
+	return *this += -n;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>
+grid_curve_iterator<T, D, Curve, Check>::operator+(difference_type n) const {
+	return grid_curve_iterator(*this) += n;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+grid_curve_iterator<T, D, Curve, Check>
+grid_curve_iterator<T, D, Curve, Check>::operator-(difference_type n) const {
+	return grid_curve_iterator(*this) -= n;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+typename grid_curve_iterator<T, D, Curve, Check>::difference_type
+grid_curve_iterator<T, D, Curve, Check>::operator-(
+  const grid_curve_iterator& rhs) const {
+	return static_cast<difference_type>(_pos) - static_cast<difference_type>(rhs._pos);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+typename grid_curve_iterator<T, D, Curve, Check>::Point
+grid_curve_iterator<T, D, Curve, Check>::point() const {
+	Point res;
+	for (std::size_t i = 0; i < D; ++i)
+		res[i] = _cell[i];
+	return res;
+}
+
+//////////////////
+//  CONVERTION  //
+//////////////////
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+std::uint64_t
+grid_curve_iterator<T, D, Curve, Check>::PointToBinary(const Point& p) const {
+	Cell cell;
+	for (std::size_t i = 0; i < D; ++i) {
+		if (p[i] >= _grid->extents[i])
+			throw std::runtime_error("Point must be in the grid extents");
+		cell[i] = static_cast<std::uint32_t>(p[i]);
+	}
+	return Curve::encode(cell, _order);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+typename grid_curve_iterator<T, D, Curve, Check>::Point
+grid_curve_iterator<T, D, Curve, Check>::BinaryToPoint(std::uint64_t d) const {
+	if ((d & ~CurveBlocks<D>::mask(_order)) != 0)
+		throw std::range_error("Distance must be in range [0, 2^(D order)-1]");
+
+	const auto cell = Curve::decode(d, _order);
+	Point res;
+	for (std::size_t i = 0; i < D; ++i)
+		res[i] = cell[i];
+	return res;
+}
+
+////////////////
+//  Skipping  //
+////////////////
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+void
+grid_curve_iterator<T, D, Curve, Check>::seek() {
+	_index = select(_pos);
+	_cell  = Curve::decode(_index, _order);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+std::uint64_t
+grid_curve_iterator<T, D, Curve, Check>::select(std::size_t pos) const {
+	if (_full) return pos; // no hole
+	return CurveBlocks<D>::select(*this, pos, _order);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+typename grid_curve_iterator<T, D, Curve, Check>::Cell
+grid_curve_iterator<T, D, Curve, Check>::decode(std::uint64_t d) const {
+	return Curve::decode(d, _order);
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+std::size_t
+grid_curve_iterator<T, D, Curve, Check>::count(const Cell& cell, unsigned k) const {
+	const std::size_t side = std::size_t(1) << k;
+	std::size_t res        = 1;
+	for (std::size_t i = 0; i < D; ++i) {
+		const std::size_t c0 = cell[i] & ~(side - 1);
+		if (c0 >= _grid->extents[i]) return 0;
+		res *= std::min(c0 + side, _grid->extents[i]) - c0;
+	}
+	return res;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+bool
+grid_curve_iterator<T, D, Curve, Check>::inside(const Cell& cell) const {
+	for (std::size_t i = 0; i < D; ++i) {
+		if (cell[i] >= _grid->extents[i]) return false;
+	}
+	return true;
+}
+
+template <typename T, std::size_t D, typename Curve, typename Check>
+void
+grid_curve_iterator<T, D, Curve, Check>::move(Cell& cell,
+                                             std::uint64_t d,
+                                             unsigned,
+                                             bool) const {
+	cell = Curve::decode(d, _order); // each step decodes
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <hilbert_codec.hpp>
+
+namespace hilbert {
+namespace details {
+
+// SIMD version of the Table backend: each 32 bits lane walks the state table of
+// one key, the table entries being fetched with gather instructions.
+// Since a key may have 8 bytes, the low (resp. high) 4 bytes of the keys are
+// accumulated in the lane "lo" (resp. "hi").
+
+#if SNIPPETS_HAS_X86
+////////////
+//  AVX2  //
+////////////
+
+//! @brief Spread the 4 low bits of each lane on the even bits of the low byte.
+SNIPPETS_TARGET_AVX2 inline __m256i
+spreadAVX2(__m256i v) {
+	v = _mm256_or_si256(v, _mm256_slli_epi32(v, 2));
+	v = _mm256_and_si256(v, _mm256_set1_epi32(0x33));
+	v = _mm256_or_si256(v, _mm256_slli_epi32(v, 1));
+	return _mm256_and_si256(v, _mm256_set1_epi32(0x55));
+}
+
+//! @brief Compact the even bits of the low byte of each lane on the 4 low bits.
+SNIPPETS_TARGET_AVX2 inline __m256i
+compactAVX2(__m256i v) {
+	v = _mm256_and_si256(v, _mm256_set1_epi32(0x55));
+	v = _mm256_or_si256(v, _mm256_srli_epi32(v, 1));
+	v = _mm256_and_si256(v, _mm256_set1_epi32(0x33));
+	v = _mm256_or_si256(v, _mm256_srli_epi32(v, 2));
+	return _mm256_and_si256(v, _mm256_set1_epi32(0x0F));
+}
+
+SNIPPETS_TARGET_AVX2 inline void
+encodeAVX2(const std::uint32_t* xs,
+           const std::uint32_t* ys,
+           std::uint64_t* out,
+           std::size_t count,
+           unsigned order) {
+	// Entries are 16 bits, gather 32 bits (scale 2) then keep the low half.
+	const int* table     = reinterpret_cast<const int*>(&kTable.encode[0][0]);
+	const int groups     = static_cast<int>((order + 3) / 4);
+	const __m256i init   = _mm256_set1_epi32(static_cast<int>(initialState(order)));
+	const __m256i nibble = _mm256_set1_epi32(0x0F);
+	const __m256i byte   = _mm256_set1_epi32(0xFF);
+	const __m256i entry  = _mm256_set1_epi32(0xFFFF);
+
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i));
+		const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i));
+		__m256i state = init;
+		__m256i lo      = _mm256_setzero_si256();
+		__m256i hi      = _mm256_setzero_si256();
+		for (int g = groups - 1; g >= 0; --g) {
+			const __m128i shift = _mm_cvtsi32_si128(4 * g);
+			const __m256i nx    = _mm256_and_si256(_mm256_srl_epi32(x, shift), nibble);
+			const __m256i ny    = _mm256_and_si256(_mm256_srl_epi32(y, shift), nibble);
+			const __m256i morton =
+			  _mm256_or_si256(spreadAVX2(nx), _mm256_slli_epi32(spreadAVX2(ny), 1));
+			const __m256i index = _mm256_or_si256(_mm256_slli_epi32(state, 8), morton);
+			const __m256i e =
+			  _mm256_and_si256(_mm256_i32gather_epi32(table, index, 2), entry);
+			__m256i& acc = g >= 4 ? hi : lo;
+			acc   = _mm256_or_si256(_mm256_slli_epi32(acc, 8), _mm256_and_si256(e, byte));
+			state = _mm256_srli_epi32(e, 8);
+		}
+		// key = hi << 32 | lo
+		for (int h = 0; h < 2; ++h) {
+			const __m256i l = _mm256_cvtepu32_epi64(
+			  h ? _mm256_extracti128_si256(lo, 1) : _mm256_castsi256_si128(lo));
+			const __m256i u = _mm256_cvtepu32_epi64(
+			  h ? _mm256_extracti128_si256(hi, 1) : _mm256_castsi256_si128(hi));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4 * h),
+			                    _mm256_or_si256(l, _mm256_slli_epi64(u, 32)));
+		}
+	}
+	for (; i < count; ++i)
+		out[i] = encodeTable(xs[i], ys[i], order);
+}
+
+SNIPPETS_TARGET_AVX2 inline void
+decodeAVX2(const std::uint64_t* ds,
+           std::uint32_t* xs,
+           std::uint32_t* ys,
+           std::size_t count,
+           unsigned order) {
+	const int* table    = reinterpret_cast<const int*>(&kTable.decode[0][0]);
+	const int groups    = static_cast<int>((order + 3) / 4);
+	const __m256i init  = _mm256_set1_epi32(static_cast<int>(initialState(order)));
+	const __m256i byte  = _mm256_set1_epi32(0xFF);
+	const __m256i entry = _mm256_set1_epi32(0xFFFF);
+	// [l0 h0 l1 h1 l2 h2 l3 h3] -> [l0 l1 l2 l3 h0 h1 h2 h3]
+	const __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256i k0 = _mm256_permutevar8x32_epi32(
+		  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ds + i)), split);
+		const __m256i k1 = _mm256_permutevar8x32_epi32(
+		  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ds + i + 4)), split);
+		const __m256i lo = _mm256_permute2x128_si256(k0, k1, 0x20);
+		const __m256i hi = _mm256_permute2x128_si256(k0, k1, 0x31);
+		__m256i state    = init;
+		__m256i x        = _mm256_setzero_si256();
+		__m256i y        = _mm256_setzero_si256();
+		for (int g = groups - 1; g >= 0; --g) {
+			const __m256i in =
+			  g >= 4 ? _mm256_srl_epi32(hi, _mm_cvtsi32_si128(8 * (g - 4)))
+			         : _mm256_srl_epi32(lo, _mm_cvtsi32_si128(8 * g));
+			const __m256i index =
+			  _mm256_or_si256(_mm256_slli_epi32(state, 8), _mm256_and_si256(in, byte));
+			const __m256i e =
+			  _mm256_and_si256(_mm256_i32gather_epi32(table, index, 2), entry);
+			const __m256i nx = compactAVX2(e);
+			const __m256i ny = compactAVX2(_mm256_srli_epi32(e, 1));
+			x                = _mm256_or_si256(_mm256_slli_epi32(x, 4), nx);
+			y                = _mm256_or_si256(_mm256_slli_epi32(y, 4), ny);
+			state            = _mm256_srli_epi32(e, 8);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(xs + i), x);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(ys + i), y);
+	}
+	for (; i < count; ++i) {
+		auto xy = decodeTable(ds[i], order);
+		xs[i]   = xy.x;
+		ys[i]   = xy.y;
+	}
+}
+
+//////////////
+//  AVX512  //
+//////////////
+
+SNIPPETS_TARGET_AVX512 inline __m512i
+spreadAVX512(__m512i v) {
+	v = _mm512_or_si512(v, _mm512_slli_epi32(v, 2));
+	v = _mm512_and_si512(v, _mm512_set1_epi32(0x33));
+	v = _mm512_or_si512(v, _mm512_slli_epi32(v, 1));
+	return _mm512_and_si512(v, _mm512_set1_epi32(0x55));
+}
+
+SNIPPETS_TARGET_AVX512 inline __m512i
+compactAVX512(__m512i v) {
+	v = _mm512_and_si512(v, _mm512_set1_epi32(0x55));
+	v = _mm512_or_si512(v, _mm512_srli_epi32(v, 1));
+	v = _mm512_and_si512(v, _mm512_set1_epi32(0x33));
+	v = _mm512_or_si512(v, _mm512_srli_epi32(v, 2));
+	return _mm512_and_si512(v, _mm512_set1_epi32(0x0F));
+}
+
+SNIPPETS_TARGET_AVX512 inline void
+encodeAVX512(const std::uint32_t* xs,
+             const std::uint32_t* ys,
+             std::uint64_t* out,
+             std::size_t count,
+             unsigned order) {
+	const void* table    = &kTable.encode[0][0];
+	const int groups     = static_cast<int>((order + 3) / 4);
+	const __m512i init   = _mm512_set1_epi32(static_cast<int>(initialState(order)));
+	const __m512i nibble = _mm512_set1_epi32(0x0F);
+	const __m512i byte   = _mm512_set1_epi32(0xFF);
+	const __m512i entry  = _mm512_set1_epi32(0xFFFF);
+
+	std::size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m512i x = _mm512_loadu_si512(xs + i);
+		const __m512i y = _mm512_loadu_si512(ys + i);
+		__m512i state   = init;
+		__m512i lo      = _mm512_setzero_si512();
+		__m512i hi      = _mm512_setzero_si512();
+		for (int g = groups - 1; g >= 0; --g) {
+			const __m128i shift = _mm_cvtsi32_si128(4 * g);
+			const __m512i nx    = _mm512_and_si512(_mm512_srl_epi32(x, shift), nibble);
+			const __m512i ny    = _mm512_and_si512(_mm512_srl_epi32(y, shift), nibble);
+			const __m512i morton =
+			  _mm512_or_si512(spreadAVX512(nx), _mm512_slli_epi32(spreadAVX512(ny), 1));
+			const __m512i index = _mm512_or_si512(_mm512_slli_epi32(state, 8), morton);
+			const __m512i e =
+			  _mm512_and_si512(_mm512_i32gather_epi32(index, table, 2), entry);
+			__m512i& acc = g >= 4 ? hi : lo;
+			acc   = _mm512_or_si512(_mm512_slli_epi32(acc, 8), _mm512_and_si512(e, byte));
+			state = _mm512_srli_epi32(e, 8);
+		}
+		// key = hi << 32 | lo
+		for (int h = 0; h < 2; ++h) {
+			const __m512i l = _mm512_cvtepu32_epi64(
+			  h ? _mm512_extracti64x4_epi64(lo, 1) : _mm512_castsi512_si256(lo));
+			const __m512i u = _mm512_cvtepu32_epi64(
+			  h ? _mm512_extracti64x4_epi64(hi, 1) : _mm512_castsi512_si256(hi));
+			_mm512_storeu_si512(out + i + 8 * h,
+			                    _mm512_or_si512(l, _mm512_slli_epi64(u, 32)));
+		}
+	}
+	for (; i < count; ++i)
+		out[i] = encodeTable(xs[i], ys[i], order);
+}
+
+SNIPPETS_TARGET_AVX512 inline void
+decodeAVX512(const std::uint64_t* ds,
+             std::uint32_t* xs,
+             std::uint32_t* ys,
+             std::size_t count,
+             unsigned order) {
+	const void* table   = &kTable.decode[0][0];
+	const int groups    = static_cast<int>((order + 3) / 4);
+	const __m512i init  = _mm512_set1_epi32(static_cast<int>(initialState(order)));
+	const __m512i byte  = _mm512_set1_epi32(0xFF);
+	const __m512i entry = _mm512_set1_epi32(0xFFFF);
+
+	std::size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m512i k0 = _mm512_loadu_si512(ds + i);
+		const __m512i k1 = _mm512_loadu_si512(ds + i + 8);
+		const __m512i lo = _mm512_inserti64x4(
+		  _mm512_castsi256_si512(_mm512_cvtepi64_epi32(k0)), _mm512_cvtepi64_epi32(k1), 1);
+		const __m512i hi = _mm512_inserti64x4(
+		  _mm512_castsi256_si512(_mm512_cvtepi64_epi32(_mm512_srli_epi64(k0, 32))),
+		  _mm512_cvtepi64_epi32(_mm512_srli_epi64(k1, 32)),
+		  1);
+		__m512i state = init;
+		__m512i x     = _mm512_setzero_si512();
+		__m512i y     = _mm512_setzero_si512();
+		for (int g = groups - 1; g >= 0; --g) {
+			const __m512i in =
+			  g >= 4 ? _mm512_srl_epi32(hi, _mm_cvtsi32_si128(8 * (g - 4)))
+			         : _mm512_srl_epi32(lo, _mm_cvtsi32_si128(8 * g));
+			const __m512i index =
+			  _mm512_or_si512(_mm512_slli_epi32(state, 8), _mm512_and_si512(in, byte));
+			const __m512i e =
+			  _mm512_and_si512(_mm512_i32gather_epi32(index, table, 2), entry);
+			const __m512i nx = compactAVX512(e);
+			const __m512i ny = compactAVX512(_mm512_srli_epi32(e, 1));
+			x                = _mm512_or_si512(_mm512_slli_epi32(x, 4), nx);
+			y                = _mm512_or_si512(_mm512_slli_epi32(y, 4), ny);
+			state            = _mm512_srli_epi32(e, 8);
+		}
+		_mm512_storeu_si512(xs + i, x);
+		_mm512_storeu_si512(ys + i, y);
+	}
+	for (; i < count; ++i) {
+		auto xy = decodeTable(ds[i], order);
+		xs[i]   = xy.x;
+		ys[i]   = xy.y;
+	}
+}
+#endif
+} // namespace details
+
+inline void
+encodeBatch(Backend backend,
+            const std::uint32_t* xs,
+            const std::uint32_t* ys,
+            std::uint64_t* out,
+            std::size_t count,
+            unsigned order) {
+#if SNIPPETS_HAS_X86
+	if (backend == Backend::AVX2) return details::encodeAVX2(xs, ys, out, count, order);
+	if (backend == Backend::AVX512)
+		return details::encodeAVX512(xs, ys, out, count, order);
+#endif
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = encode(backend, xs[i], ys[i], order);
+}
+
+inline void
+decodeBatch(Backend backend,
+            const std::uint64_t* ds,
+            std::uint32_t* xs,
+            std::uint32_t* ys,
+            std::size_t count,
+            unsigned order) {
+#if SNIPPETS_HAS_X86
+	if (backend == Backend::AVX2) return details::decodeAVX2(ds, xs, ys, count, order);
+	if (backend == Backend::AVX512)
+		return details::decodeAVX512(ds, xs, ys, count, order);
+#endif
+	for (std::size_t i = 0; i < count; ++i) {
+		auto xy = decode(backend, ds[i], order);
+		xs[i]   = xy.x;
+		ys[i]   = xy.y;
+	}
+}
+
+inline void
+encodeBatch(const std::uint32_t* xs,
+            const std::uint32_t* ys,
+            std::uint64_t* out,
+            std::size_t count,
+            unsigned order) {
+	static const Backend backend = bestBatchBackend();
+	encodeBatch(backend, xs, ys, out, count, order);
+}
+
+inline void
+decodeBatch(const std::uint64_t* ds,
+            std::uint32_t* xs,
+            std::uint32_t* ys,
+            std::size_t count,
+            unsigned order) {
+	static const Backend backend = bestBatchBackend();
+	decodeBatch(backend, ds, xs, ys, count, order);
+}
+} // namespace hilbert
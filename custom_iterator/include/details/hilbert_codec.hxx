@@ -0,0 +1,282 @@
+#pragma once
+
+#include <hilbert_codec.hpp>
+
+namespace hilbert {
+namespace details {
+
+// The curve is described top-down as a state machine: the state is the
+// orientation of the sub curve entering a level (bit 0: x/y swap, bit 1: x/y
+// complement) and each level consume one base 4 digit of the index.
+
+//! @brief Quadrant (x | y << 1) of a digit for a given orientation.
+constexpr unsigned
+quadrant(unsigned state, unsigned digit) {
+	unsigned rx = digit >> 1;
+	unsigned ry = (digit ^ rx) & 1;
+	if (state & 1) {
+		const unsigned t = rx;
+		rx               = ry;
+		ry               = t;
+	}
+	if (state & 2) {
+		rx ^= 1;
+		ry ^= 1;
+	}
+	return rx | (ry << 1);
+}
+
+//! @brief Digit of a quadrant (x | y << 1) for a given orientation.
+constexpr unsigned
+digit(unsigned state, unsigned quadrant) {
+	unsigned rx = quadrant & 1;
+	unsigned ry = quadrant >> 1;
+	if (state & 2) {
+		rx ^= 1;
+		ry ^= 1;
+	}
+	if (state & 1) {
+		const unsigned t = rx;
+		rx               = ry;
+		ry               = t;
+	}
+	return (3 * rx) ^ ry;
+}
+
+//! @brief Orientation of the sub curve of a digit.
+constexpr unsigned
+next(unsigned state, unsigned digit) {
+	return state ^ (digit == 0 ? 1 : (digit == 3 ? 3 : 0));
+}
+
+//! @brief Orientation entering the top level when order is padded to a
+//! multiple of 4 (each padding level has digit 0 thus swap x/y).
+constexpr unsigned
+initialState(unsigned order) {
+	return ((4 - order % 4) % 4) & 1;
+}
+
+//! @struct Table Process four levels at once.
+//! entry = output byte | next state << 8, indexed by [state][input byte].
+//! Encode input is the Morton byte (x on even bits), output the index byte.
+//! Decode input is the index byte, output the Morton byte.
+struct Table {
+	std::uint16_t encode[4][256];
+	std::uint16_t decode[4][256];
+	std::uint8_t spread[16];   // 4 bits -> even bits of a byte
+	std::uint8_t compact[256]; // even bits -> low nibble, odd bits -> high nibble
+};
+
+constexpr Table
+makeTable() {
+	Table table{};
+	for (unsigned s = 0; s < 4; ++s) {
+		for (unsigned in = 0; in < 256; ++in) {
+			unsigned es = s, eo = 0;
+			unsigned ds = s, dout = 0;
+			for (int l = 3; l >= 0; --l) {
+				const unsigned pair = (in >> (2 * l)) & 3;
+				const unsigned d    = digit(es, pair);
+				eo |= d << (2 * l);
+				es = next(es, d);
+				dout |= quadrant(ds, pair) << (2 * l);
+				ds = next(ds, pair);
+			}
+			table.encode[s][in] = static_cast<std::uint16_t>(eo | (es << 8));
+			table.decode[s][in] = static_cast<std::uint16_t>(dout | (ds << 8));
+		}
+	}
+	for (unsigned i = 0; i < 16; ++i) {
+		for (unsigned b = 0; b < 4; ++b)
+			table.spread[i] |= static_cast<std::uint8_t>(((i >> b) & 1) << (2 * b));
+	}
+	for (unsigned i = 0; i < 256; ++i) {
+		for (unsigned b = 0; b < 4; ++b) {
+			const unsigned bx = (i >> (2 * b)) & 1;
+			const unsigned by = (i >> (2 * b + 1)) & 1;
+			table.compact[i] |= static_cast<std::uint8_t>((bx << b) | (by << (b + 4)));
+		}
+	}
+	return table;
+}
+
+inline constexpr Table kTable = makeTable();
+
+// rotate/flip a quadrant appropriately
+inline void
+rot(std::uint64_t n,
+    std::uint64_t& x,
+    std::uint64_t& y,
+    std::uint64_t rx,
+    std::uint64_t ry) {
+	if (ry == 0) {
+		if (rx == 1) {
+			x = n - 1 - x;
+			y = n - 1 - y;
+		}
+		// Swap x and y
+		std::uint64_t t = x;
+		x               = y;
+		y               = t;
+	}
+}
+
+//////////////
+//  Scalar  //
+//////////////
+
+inline std::uint64_t
+encodeScalar(std::uint32_t x, std::uint32_t y, unsigned order) {
+	std::uint64_t vx = x, vy = y;
+	std::uint64_t rx, ry, d = 0;
+	for (std::uint64_t s = (std::uint64_t(1) << order) / 2; s > 0; s /= 2) {
+		rx = (vx & s) > 0;
+		ry = (vy & s) > 0;
+		d += s * s * ((3 * rx) ^ ry);
+		rot(s, vx, vy, rx, ry);
+	}
+	return d;
+}
+
+inline Vector<std::uint32_t>
+decodeScalar(std::uint64_t d, unsigned order) {
+	const std::uint64_t n = std::uint64_t(1) << order;
+	std::uint64_t x = 0, y = 0;
+	std::uint64_t rx, ry, s, t = d;
+	for (s = 1; s < n; s *= 2) {
+		rx = 1 & (t / 2);
+		ry = 1 & (t ^ rx);
+		rot(s, x, y, rx, ry);
+		x += s * rx;
+		y += s * ry;
+		t /= 4;
+	}
+	return Vector<std::uint32_t>(static_cast<std::uint32_t>(x),
+	                             static_cast<std::uint32_t>(y));
+}
+
+/////////////
+//  Table  //
+/////////////
+
+inline std::uint64_t
+encodeTable(std::uint32_t x, std::uint32_t y, unsigned order) {
+	std::uint64_t d = 0;
+	unsigned state  = initialState(order);
+	for (int g = static_cast<int>((order + 3) / 4) - 1; g >= 0; --g) {
+		const unsigned m = kTable.spread[(x >> (4 * g)) & 15] |
+		                   (kTable.spread[(y >> (4 * g)) & 15] << 1);
+		const std::uint16_t e = kTable.encode[state][m];
+		d                     = (d << 8) | (e & 0xFF);
+		state                 = e >> 8;
+	}
+	return d;
+}
+
+inline Vector<std::uint32_t>
+decodeTable(std::uint64_t d, unsigned order) {
+	std::uint32_t x = 0, y = 0;
+	unsigned state  = initialState(order);
+	for (int g = static_cast<int>((order + 3) / 4) - 1; g >= 0; --g) {
+		const std::uint16_t e = kTable.decode[state][(d >> (8 * g)) & 0xFF];
+		const unsigned xy     = kTable.compact[e & 0xFF];
+		x                     = (x << 4) | (xy & 15);
+		y                     = (y << 4) | (xy >> 4);
+		state                 = e >> 8;
+	}
+	return Vector<std::uint32_t>(x, y);
+}
+
+////////////
+//  BMI2  //
+////////////
+
+#if SNIPPETS_HAS_X86
+SNIPPETS_TARGET_BMI2 inline std::uint64_t
+encodeBMI2(std::uint32_t x, std::uint32_t y, unsigned order) {
+	const std::uint64_t m =
+	  _pdep_u64(x, 0x5555555555555555ULL) | _pdep_u64(y, 0xAAAAAAAAAAAAAAAAULL);
+	std::uint64_t d = 0;
+	unsigned state  = initialState(order);
+	for (int g = static_cast<int>((order + 3) / 4) - 1; g >= 0; --g) {
+		const std::uint16_t e = kTable.encode[state][(m >> (8 * g)) & 0xFF];
+		d                     = (d << 8) | (e & 0xFF);
+		state                 = e >> 8;
+	}
+	return d;
+}
+
+SNIPPETS_TARGET_BMI2 inline Vector<std::uint32_t>
+decodeBMI2(std::uint64_t d, unsigned order) {
+	std::uint64_t m = 0;
+	unsigned state  = initialState(order);
+	for (int g = static_cast<int>((order + 3) / 4) - 1; g >= 0; --g) {
+		const std::uint16_t e = kTable.decode[state][(d >> (8 * g)) & 0xFF];
+		m                     = (m << 8) | (e & 0xFF);
+		state                 = e >> 8;
+	}
+	return Vector<std::uint32_t>(
+	  static_cast<std::uint32_t>(_pext_u64(m, 0x5555555555555555ULL)),
+	  static_cast<std::uint32_t>(_pext_u64(m, 0xAAAAAAAAAAAAAAAAULL)));
+}
+#endif
+} // namespace details
+
+inline std::uint64_t
+encode(Backend backend, std::uint32_t x, std::uint32_t y, unsigned order) {
+	switch (backend) {
+		case Backend::Scalar:
+			return details::encodeScalar(x, y, order);
+		case Backend::Table:
+		case Backend::AVX2:
+		case Backend::AVX512:
+			return details::encodeTable(x, y, order);
+		case Backend::BMI2:
+#if SNIPPETS_HAS_X86
+			return details::encodeBMI2(x, y, order);
+#else
+			return details::encodeTable(x, y, order);
+#endif
+	}
+	return details::encodeScalar(x, y, order);
+}
+
+inline Vector<std::uint32_t>
+decode(Backend backend, std::uint64_t d, unsigned order) {
+	switch (backend) {
+		case Backend::Scalar:
+			return details::decodeScalar(d, order);
+		case Backend::Table:
+		case Backend::AVX2:
+		case Backend::AVX512:
+			return details::decodeTable(d, order);
+		case Backend::BMI2:
+#if SNIPPETS_HAS_X86
+			return details::decodeBMI2(d, order);
+#else
+			return details::decodeTable(d, order);
+#endif
+	}
+	return details::decodeScalar(d, order);
+}
+
+inline std::uint64_t
+encode(std::uint32_t x, std::uint32_t y, unsigned order) {
+#if SNIPPETS_HAS_X86
+	static const auto func = hasBMI2() ? &details::encodeBMI2 : &details::encodeTable;
+	return func(x, y, order);
+#else
+	return details::encodeTable(x, y, order);
+#endif
+}
+
+inline Vector<std::uint32_t>
+decode(std::uint64_t d, unsigned order) {
+#if SNIPPETS_HAS_X86
+	static const auto func = hasBMI2() ? &details::decodeBMI2 : &details::decodeTable;
+	return func(d, order);
+#else
+	return details::decodeTable(d, order);
+#endif
+}
+} // namespace hilbert
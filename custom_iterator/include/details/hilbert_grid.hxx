@@ -0,0 +1,128 @@
+#pragma once
+
+#include <hilbert_grid.hpp>
+
+namespace hilbert {
+namespace details {
+
+// J. Skilling, "Programming the Hilbert curve" (2004): the curve index is the
+// Morton interleave of the "transposed" coordinates (axis 0 on the most
+// significant bit of each level), which are computed in place.
+
+//! @brief Invert the low bits (mask) of the axis 0 if the bit q of the axis i
+//! is set, else exchange the low bits of the axes 0 and i (branch free).
+template <std::size_t D>
+constexpr void
+invertOrExchange(std::array<std::uint32_t, D>& p,
+                 std::size_t i,
+                 std::uint32_t q,
+                 std::uint32_t mask) {
+	const std::uint32_t set = 0u - static_cast<std::uint32_t>((p[i] & q) != 0);
+	const std::uint32_t t   = (p[0] ^ p[i]) & mask & ~set;
+	p[0] ^= (mask & set) | t;
+	p[i] ^= t;
+}
+
+template <std::size_t D>
+constexpr void
+axesToTranspose(std::array<std::uint32_t, D>& p, unsigned order) {
+	if (order == 0) return;
+	const std::uint32_t m = std::uint32_t(1) << (order - 1);
+	// Inverse undo.
+	for (std::uint32_t q = m; q > 1; q >>= 1) {
+		const std::uint32_t mask = q - 1;
+		for (std::size_t i = 0; i < D; ++i)
+			invertOrExchange(p, i, q, mask);
+	}
+	// Gray encode.
+	for (std::size_t i = 1; i < D; ++i)
+		p[i] ^= p[i - 1];
+	std::uint32_t t = 0;
+	for (std::uint32_t q = m; q > 1; q >>= 1) {
+		if (p[D - 1] & q) t ^= q - 1;
+	}
+	for (std::size_t i = 0; i < D; ++i)
+		p[i] ^= t;
+}
+
+template <std::size_t D>
+constexpr void
+transposeToAxes(std::array<std::uint32_t, D>& p, unsigned order) {
+	if (order == 0) return;
+	// Gray decode.
+	const std::uint32_t t = p[D - 1] >> 1;
+	for (std::size_t i = D - 1; i > 0; --i)
+		p[i] ^= p[i - 1];
+	p[0] ^= t;
+	// Undo excess work.
+	for (unsigned b = 1; b < order; ++b) {
+		const std::uint32_t q    = std::uint32_t(1) << b;
+		const std::uint32_t mask = q - 1;
+		// Axes D - 1 to 0, the last one apart so GCC unrolls the loop.
+		for (std::size_t i = D - 1; i > 0; --i)
+			invertOrExchange(p, i, q, mask);
+		invertOrExchange(p, 0, q, mask);
+	}
+}
+} // namespace details
+
+template <std::size_t D>
+std::uint64_t
+encode(const std::array<std::uint32_t, D>& p, unsigned order) {
+	auto t = p;
+	details::axesToTranspose(t, order);
+	std::uint64_t res = 0;
+	for (std::size_t i = 0; i < D; ++i)
+		res |= morton::details::spread<D>(t[i], order) << (D - 1 - i);
+	return res;
+}
+
+template <std::size_t D>
+std::array<std::uint32_t, D>
+decode(std::uint64_t d, unsigned order) {
+	std::array<std::uint32_t, D> res;
+	for (std::size_t i = 0; i < D; ++i)
+		res[i] = morton::details::compact<D>(d >> (D - 1 - i), order);
+	details::transposeToAxes(res, order);
+	return res;
+}
+
+template <std::size_t D>
+void
+encodeBatch(const std::array<const std::uint32_t*, D>& coords,
+            std::uint64_t* out,
+            std::size_t count,
+            unsigned order) {
+	std::array<std::uint32_t, D> p;
+	for (std::size_t j = 0; j < count; ++j) {
+		for (std::size_t i = 0; i < D; ++i)
+			p[i] = coords[i][j];
+		out[j] = hilbert::encode<D>(p, order);
+	}
+}
+
+template <std::size_t D>
+void
+decodeBatch(const std::uint64_t* ds,
+            const std::array<std::uint32_t*, D>& coords,
+            std::size_t count,
+            unsigned order) {
+	for (std::size_t j = 0; j < count; ++j) {
+		const auto p = hilbert::decode<D>(ds[j], order);
+		for (std::size_t i = 0; i < D; ++i)
+			coords[i][j] = p[i];
+	}
+}
+
+template <std::size_t D>
+std::uint64_t
+GridCurve<D>::encode(const std::array<std::uint32_t, D>& p, unsigned order) {
+	return hilbert::encode<D>(p, order);
+}
+
+template <std::size_t D>
+std::array<std::uint32_t, D>
+GridCurve<D>::decode(std::uint64_t d, unsigned order) {
+	return hilbert::decode<D>(d, order);
+}
+}
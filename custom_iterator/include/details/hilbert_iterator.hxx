@@ -1,131 +1,62 @@
 #pragma once
 
-#include <cmath>
+#include <hilbert_codec.hpp>
 #include <hilbert_iterator.hpp>
 
 namespace hilbert {
 
-template <typename T>
-iterator<T>::iterator(Matrix<T>& mat, std::size_t pos)
-  : _mat(mat)
-  , _pos(pos) {
-	// std::cout << "hilbert::iterator::iterator() called\n";
-}
-
-template <typename T>
-iterator<T>::~iterator() {
-	// std::cout << "hilbert::iterator::~iterator() called\n";
-}
-
-template <typename T>
-iterator<T>
-iterator<T>::begin() const {
-	return iterator<T>(_mat);
-}
-
-template <typename T>
-iterator<T>
-iterator<T>::end() const {
-	return iterator<T>(_mat, _mat.size());
-}
-
-template <typename T>
-bool
-iterator<T>::operator==(const iterator<T>& rhs) const {
-	if (&_mat != &rhs._mat)
-		throw std::runtime_error("iterator not on the same container");
-	return _pos == rhs._pos;
-}
-
-template <typename T>
-bool
-iterator<T>::operator!=(const iterator<T>& rhs) const {
-	return !(*this == rhs);
-}
-
-template <typename T>
-T& iterator<T>::operator*() {
-	auto res = BinaryToXY(_pos);    // From _pos compute x, y
-	return _mat.data[res.y][res.x]; // From x, y retrieve the value
-}
-
-template <typename T>
-iterator<T>& iterator<T>::operator++() { // prefix
-	++_pos;
-	return *this;
-}
-
-template <typename T>
-iterator<T> iterator<T>::operator++(int) { // postfix
-	iterator res(_mat, _pos);
-	++(*this);
-	return res;
-}
-
-template <typename T>
-iterator<T>& iterator<T>::operator--() { // prefix
-	--_pos;
-	return *this;
-}
-
-template <typename T>
-iterator<T> iterator<T>::operator--(int) { // postfix
-	iterator res(_mat, _pos);
-	--(*this);
-	return res;
-}
-
-//////////////////
-//  CONVERTION  //
-//////////////////
-
-// rotate/flip a quadrant appropriately
-void
-rot(std::size_t n, std::size_t& x, std::size_t& y, std::size_t rx, std::size_t ry) {
-	if (ry == 0) {
-		if (rx == 1) {
-			x = n - 1 - x;
-			y = n - 1 - y;
+inline void
+Curve::seek(State& s, std::size_t pos, unsigned order) {
+	s.x = s.y = 0;
+	if (order == 0) return;
+	s.states &= ~(std::uint64_t(3) << (2 * (order - 1)));
+	update(s, pos, order - 1);
+}
+
+inline void
+Curve::next(State& s, std::size_t pos, unsigned order) {
+	// Digits (base 4) equal to 3 became 0 and the next one has been incremented.
+	unsigned level = 0;
+	while (level < order && ((pos >> (2 * level)) & 3) == 0) ++level;
+	if (level < order) update(s, pos, level);
+}
+
+inline void
+Curve::prev(State& s, std::size_t pos, unsigned order) {
+	// Digits (base 4) equal to 0 became 3 and the next one has been decremented.
+	unsigned level = 0;
+	while (level < order && ((pos >> (2 * level)) & 3) == 3) ++level;
+	if (level < order) update(s, pos, level);
+}
+
+inline void
+Curve::update(State& s, std::size_t pos, unsigned level) {
+	for (unsigned l = level + 1; l-- > 0;) {
+		const unsigned state = (s.states >> (2 * l)) & 3;
+		const unsigned digit = (pos >> (2 * l)) & 3;
+		const unsigned quad  = details::quadrant(state, digit);
+		s.x = (s.x & ~(std::size_t(1) << l)) | (std::size_t(quad & 1) << l);
+		s.y = (s.y & ~(std::size_t(1) << l)) | (std::size_t(quad >> 1) << l);
+		if (l > 0) {
+			const std::uint64_t next = details::next(state, digit);
+			const unsigned shift     = 2 * (l - 1);
+			s.states = (s.states & ~(std::uint64_t(3) << shift)) | (next << shift);
 		}
-		// Swap x and y
-		std::size_t t = x;
-		x             = y;
-		y             = t;
 	}
 }
 
-template <typename T>
-std::size_t
-iterator<T>::XYToBinary(Vector<std::size_t> vec) const {
-	if (vec.x < 0 || vec.x >= _mat.n || vec.y < 0 || vec.y >= _mat.n)
-		throw std::runtime_error("X,Y must be in [0;n-1]");
-
-	std::size_t rx, ry, d = 0;
-	for (std::size_t s = _mat.n / 2; s > 0; s /= 2) {
-		rx = (vec.x & s) > 0;
-		ry = (vec.y & s) > 0;
-		d += s * s * ((3 * rx) ^ ry);
-		rot(s, vec.x, vec.y, rx, ry);
-	}
-	return d;
+inline std::uint64_t
+Curve::encode(std::uint32_t x, std::uint32_t y, unsigned order) {
+	return hilbert::encode(x, y, order);
 }
 
-template <typename T>
-Vector<std::size_t>
-iterator<T>::BinaryToXY(std::size_t d) const {
-	if (d < 0 || d > _mat.size() - 1)
-		throw std::range_error("Distance must be in range [0, n^2-1]");
+inline Vector<std::uint32_t>
+Curve::decode(std::uint64_t d, unsigned order) {
+	return hilbert::decode(d, order);
+}
 
-	Vector<std::size_t> out(0, 0);
-	std::size_t rx, ry, s, t = d;
-	for (s = 1; s < _mat.n; s *= 2) {
-		rx = 1 & (t / 2);
-		ry = 1 & (t ^ rx);
-		rot(s, out.x, out.y, rx, ry);
-		out.x += s * rx;
-		out.y += s * ry;
-		t /= 4;
-	}
-	return out;
+inline Vector<std::size_t>
+Curve::block(unsigned k, unsigned) {
+	return Vector<std::size_t>(std::size_t(1) << k, std::size_t(1) << k);
 }
 }
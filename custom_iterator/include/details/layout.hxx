@@ -0,0 +1,49 @@
+#pragma once
+
+#include <layout.hpp>
+
+inline std::size_t
+RowMajor::storage(std::size_t width, std::size_t height, unsigned) {
+	return width * height;
+}
+
+inline std::size_t
+RowMajor::offset(std::size_t x, std::size_t y, std::size_t width, unsigned) {
+	return y * width + x;
+}
+
+template <typename Curve, unsigned TileOrder>
+std::size_t
+Tiled<Curve, TileOrder>::storage(std::size_t width,
+                                 std::size_t height,
+                                 unsigned order) {
+	const unsigned k    = order < TileOrder ? order : TileOrder;
+	const std::size_t m = (std::size_t(1) << k) - 1;
+	return (((width + m) >> k) * ((height + m) >> k)) << (2 * k);
+}
+
+template <typename Curve, unsigned TileOrder>
+std::size_t
+Tiled<Curve, TileOrder>::offset(std::size_t x,
+                                std::size_t y,
+                                std::size_t width,
+                                unsigned order) {
+	const unsigned k       = order < TileOrder ? order : TileOrder;
+	const std::size_t m    = (std::size_t(1) << k) - 1;
+	const std::size_t tile = (y >> k) * ((width + m) >> k) + (x >> k);
+	return (tile << (2 * k)) | _lut[((y & m) << TileOrder) | (x & m)];
+}
+
+template <typename Curve, unsigned TileOrder>
+std::vector<std::uint16_t>
+Tiled<Curve, TileOrder>::makeLut() {
+	const std::uint32_t side = std::uint32_t(1) << TileOrder;
+	std::vector<std::uint16_t> lut(std::size_t(side) * side);
+	for (std::uint32_t y = 0; y < side; ++y) {
+		for (std::uint32_t x = 0; x < side; ++x) {
+			const auto d              = Curve::encode(x, y, TileOrder);
+			lut[(y << TileOrder) | x] = static_cast<std::uint16_t>(d);
+		}
+	}
+	return lut;
+}
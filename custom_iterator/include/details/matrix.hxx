@@ -2,48 +2,207 @@
 
 #include <matrix.hpp>
 
+#include <iomanip>
 #include <stdexcept>
 
-template <typename T>
-Matrix<T>::Matrix(std::size_t n, const T& value)
-  : n(n)
-  , data(n, std::vector<T>(n, value)) {
-	if ((n == 0) || (n & (n - 1))) throw std::runtime_error("N must be a power of two.");
+template <typename T, typename Layout>
+Matrix<T, Layout>::Matrix(std::size_t n, const T& value)
+  : Matrix(Vector<std::size_t>(n, n), value) {}
+
+template <typename T, typename Layout>
+Matrix<T, Layout>::Matrix(Vector<std::size_t> extents, const T& value)
+  : width(extents.x)
+  , height(extents.y)
+  , n(width < height ? height : width)
+  , order(log2(width && height ? n : 0))
+  , data(width, height, order, value) {
 	// std::cout << "Matrix::Matrix() called\n";
 }
 
-template <typename T>
-Matrix<T>::~Matrix() {
+template <typename T, typename Layout>
+Matrix<T, Layout>::Matrix(view_t, Vector<std::size_t> extents, T* values)
+  : width(extents.x)
+  , height(extents.y)
+  , n(width < height ? height : width)
+  , order(log2(width && height ? n : 0))
+  , data(matrix_view, width, height, order, values) {}
+
+template <typename T, typename Layout>
+Matrix<T, Layout>::~Matrix() {
 	// std::cout << "Matrix::~Matrix() called\n";
 }
 
-template <typename T>
+template <typename T, typename Layout>
+unsigned
+Matrix<T, Layout>::log2(std::size_t n) {
+	if (n == 0) throw std::runtime_error("Width and height must be positive.");
+	unsigned res = 0;
+	while ((std::size_t(1) << res) < n) ++res;
+	return res;
+}
+
+template <typename T, typename Layout>
+std::size_t
+Matrix<T, Layout>::size() const {
+	return width * height;
+}
+
+template <typename T, typename Layout>
+T&
+Matrix<T, Layout>::operator()(std::size_t x, std::size_t y) {
+	return data.at(x, y);
+}
+
+template <typename T, typename Layout>
+const T&
+Matrix<T, Layout>::operator()(std::size_t x, std::size_t y) const {
+	return data.at(x, y);
+}
+
+template <typename T, typename Layout>
+T& Matrix<T, Layout>::operator[](std::size_t pos) {
+	if constexpr (Layout::contiguousRows)
+		return data.get()[pos];
+	else
+		return data.at(pos % width, pos / width);
+}
+
+template <typename T, typename Layout>
+const T& Matrix<T, Layout>::operator[](std::size_t pos) const {
+	if constexpr (Layout::contiguousRows)
+		return data.get()[pos];
+	else
+		return data.at(pos % width, pos / width);
+}
+
+template <typename T, typename Layout>
+T*
+Matrix<T, Layout>::row(std::size_t y) {
+	static_assert(Layout::contiguousRows, "Rows are not contiguous in this layout.");
+	return data[y];
+}
+
+template <typename T, typename Layout>
+const T*
+Matrix<T, Layout>::row(std::size_t y) const {
+	static_assert(Layout::contiguousRows, "Rows are not contiguous in this layout.");
+	return data[y];
+}
+
+//////////////
+//  Buffer  //
+//////////////
+
+template <typename T, typename Layout>
+Matrix<T, Layout>::Buffer::Buffer(std::size_t width,
+                                  std::size_t height,
+                                  unsigned order,
+                                  const T& value)
+  : _width(width)
+  , _order(order)
+  , _values(Layout::storage(width, height, order), value)
+  , _data(_values.data())
+  , _size(_values.size()) {}
+
+template <typename T, typename Layout>
+Matrix<T, Layout>::Buffer::Buffer(view_t,
+                                  std::size_t width,
+                                  std::size_t height,
+                                  unsigned order,
+                                  T* values)
+  : _width(width)
+  , _order(order)
+  , _values()
+  , _data(values)
+  , _size(Layout::storage(width, height, order)) {}
+
+template <typename T, typename Layout>
+Matrix<T, Layout>::Buffer::Buffer(const Buffer& rhs)
+  : _width(rhs._width)
+  , _order(rhs._order)
+  , _values(rhs._data, rhs._data + rhs._size)
+  , _data(_values.data())
+  , _size(rhs._size) {}
+
+template <typename T, typename Layout>
+auto Matrix<T, Layout>::Buffer::operator[](std::size_t y) {
+	if constexpr (Layout::contiguousRows)
+		return _data + y * _width;
+	else
+		return Row<T, Buffer>(*this, y);
+}
+
+template <typename T, typename Layout>
+auto Matrix<T, Layout>::Buffer::operator[](std::size_t y) const {
+	if constexpr (Layout::contiguousRows)
+		return _data + y * _width;
+	else
+		return Row<const T, const Buffer>(*this, y);
+}
+
+template <typename T, typename Layout>
+T*
+Matrix<T, Layout>::Buffer::get() {
+	return _data;
+}
+
+template <typename T, typename Layout>
+const T*
+Matrix<T, Layout>::Buffer::get() const {
+	return _data;
+}
+
+template <typename T, typename Layout>
 std::size_t
-Matrix<T>::size() const {
-	return std::pow(n, 2);
+Matrix<T, Layout>::Buffer::size() const {
+	return _size;
+}
+
+template <typename T, typename Layout>
+T&
+Matrix<T, Layout>::Buffer::at(std::size_t x, std::size_t y) {
+	return _data[Layout::offset(x, y, _width, _order)];
+}
+
+template <typename T, typename Layout>
+const T&
+Matrix<T, Layout>::Buffer::at(std::size_t x, std::size_t y) const {
+	return _data[Layout::offset(x, y, _width, _order)];
 }
 
-template <typename T>
-typename Matrix<T>::iterator
-Matrix<T>::begin() {
+template <typename T, typename Layout>
+template <typename U, typename B>
+Matrix<T, Layout>::Buffer::template Row<U, B>::Row(B& buffer, std::size_t y)
+  : _buffer(buffer)
+  , _y(y) {}
+
+template <typename T, typename Layout>
+template <typename U, typename B>
+U& Matrix<T, Layout>::Buffer::template Row<U, B>::operator[](std::size_t x) const {
+	return _buffer.at(x, _y);
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator
+Matrix<T, Layout>::begin() {
 	return iterator(*this);
 }
 
-template <typename T>
-typename Matrix<T>::iterator
-Matrix<T>::end() {
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator
+Matrix<T, Layout>::end() {
 	return iterator(*this, size());
 }
 
-template <typename T>
-typename Matrix<T>::const_iterator
-Matrix<T>::begin() const {
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator
+Matrix<T, Layout>::begin() const {
 	return const_iterator(*this);
 }
 
-template <typename T>
-typename Matrix<T>::const_iterator
-Matrix<T>::end() const {
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator
+Matrix<T, Layout>::end() const {
 	return const_iterator(*this, size());
 }
 
@@ -51,125 +210,268 @@ Matrix<T>::end() const {
 //  iterator  //
 ////////////////
 
-template <typename T>
-Matrix<T>::iterator::iterator(Matrix<T>& mat, std::size_t pos)
-  : _mat(mat)
+template <typename T, typename Layout>
+Matrix<T, Layout>::iterator::iterator()
+  : _mat(nullptr)
+  , _pos(0) {}
+
+template <typename T, typename Layout>
+Matrix<T, Layout>::iterator::iterator(Matrix<T, Layout>& mat, std::size_t pos)
+  : _mat(&mat)
   , _pos(pos) {}
 
-template <typename T>
+template <typename T, typename Layout>
 bool
-Matrix<T>::iterator::operator==(const iterator& rhs) {
-	if (&_mat != &rhs._mat)
-		throw std::runtime_error("iterator not on the same container");
+Matrix<T, Layout>::iterator::operator==(const iterator& rhs) const {
+	if constexpr (DefaultCheck::enabled) {
+		if (_mat != rhs._mat)
+			throw std::runtime_error("iterator not on the same container");
+	}
 	return _pos == rhs._pos;
 }
 
-template <typename T>
+template <typename T, typename Layout>
 bool
-Matrix<T>::iterator::operator!=(const iterator& rhs) {
+Matrix<T, Layout>::iterator::operator!=(const iterator& rhs) const {
 	return !(*this == rhs);
 }
 
-template <typename T>
-T& Matrix<T>::iterator::operator*() {
-	return _mat.data[_pos / _mat.n][_pos % _mat.n];
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::iterator::operator<(const iterator& rhs) const {
+	return _pos < rhs._pos;
+}
+
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::iterator::operator>(const iterator& rhs) const {
+	return rhs < *this;
+}
+
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::iterator::operator<=(const iterator& rhs) const {
+	return !(rhs < *this);
 }
 
-template <typename T>
-typename Matrix<T>::iterator& Matrix<T>::iterator::operator++() { // prefix
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::iterator::operator>=(const iterator& rhs) const {
+	return !(*this < rhs);
+}
+
+template <typename T, typename Layout>
+T& Matrix<T, Layout>::iterator::operator*() const {
+	return (*_mat)[_pos];
+}
+
+template <typename T, typename Layout>
+T& Matrix<T, Layout>::iterator::operator[](difference_type n) const {
+	return (*_mat)[_pos + n];
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator&
+Matrix<T, Layout>::iterator::operator++() { // prefix
 	++_pos;
 	return *this;
 }
 
-template <typename T>
-typename Matrix<T>::iterator Matrix<T>::iterator::operator++(int) { // postfix
-	iterator res(_mat, _pos);
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator
+Matrix<T, Layout>::iterator::operator++(int) { // postfix
+	iterator res(*this);
 	++(*this);
 	return res;
 }
 
-template <typename T>
-typename Matrix<T>::iterator& Matrix<T>::iterator::operator--() { // prefix
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator&
+Matrix<T, Layout>::iterator::operator--() { // prefix
 	--_pos;
 	return *this;
 }
 
-template <typename T>
-typename Matrix<T>::iterator Matrix<T>::iterator::operator--(int) { // postfix
-	iterator res(_mat, _pos);
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator
+Matrix<T, Layout>::iterator::operator--(int) { // postfix
+	iterator res(*this);
 	--(*this);
 	return res;
 }
 
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator&
+Matrix<T, Layout>::iterator::operator+=(difference_type n) {
+	_pos += n;
+	return *this;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator&
+Matrix<T, Layout>::iterator::operator-=(difference_type n) {
+	_pos -= n;
+	return *this;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator
+Matrix<T, Layout>::iterator::operator+(difference_type n) const {
+	return iterator(*this) += n;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator
+Matrix<T, Layout>::iterator::operator-(difference_type n) const {
+	return iterator(*this) -= n;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::iterator::difference_type
+Matrix<T, Layout>::iterator::operator-(const iterator& rhs) const {
+	return static_cast<difference_type>(_pos) - static_cast<difference_type>(rhs._pos);
+}
+
 //////////////////////
 //  const_iterator  //
 //////////////////////
 
-template <typename T>
-Matrix<T>::const_iterator::const_iterator(const Matrix<T>& mat, std::size_t pos)
-  : _mat(mat)
+template <typename T, typename Layout>
+Matrix<T, Layout>::const_iterator::const_iterator()
+  : _mat(nullptr)
+  , _pos(0) {}
+
+template <typename T, typename Layout>
+Matrix<T, Layout>::const_iterator::const_iterator(const Matrix<T, Layout>& mat,
+                                                  std::size_t pos)
+  : _mat(&mat)
   , _pos(pos) {}
 
-template <typename T>
+template <typename T, typename Layout>
 bool
-Matrix<T>::const_iterator::operator==(const const_iterator& rhs) {
-	if (&_mat != &rhs._mat)
-		throw std::runtime_error("const_iterator not on the same container");
+Matrix<T, Layout>::const_iterator::operator==(const const_iterator& rhs) const {
+	if constexpr (DefaultCheck::enabled) {
+		if (_mat != rhs._mat)
+			throw std::runtime_error("const_iterator not on the same container");
+	}
 	return _pos == rhs._pos;
 }
 
-template <typename T>
+template <typename T, typename Layout>
 bool
-Matrix<T>::const_iterator::operator!=(const const_iterator& rhs) {
+Matrix<T, Layout>::const_iterator::operator!=(const const_iterator& rhs) const {
 	return !(*this == rhs);
 }
 
-template <typename T>
-const T& Matrix<T>::const_iterator::operator*() {
-	return _mat.data[_pos / _mat.n][_pos % _mat.n];
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::const_iterator::operator<(const const_iterator& rhs) const {
+	return _pos < rhs._pos;
 }
 
-template <typename T>
-typename Matrix<T>::const_iterator& Matrix<T>::const_iterator::operator++() { // prefix
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::const_iterator::operator>(const const_iterator& rhs) const {
+	return rhs < *this;
+}
+
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::const_iterator::operator<=(const const_iterator& rhs) const {
+	return !(rhs < *this);
+}
+
+template <typename T, typename Layout>
+bool
+Matrix<T, Layout>::const_iterator::operator>=(const const_iterator& rhs) const {
+	return !(*this < rhs);
+}
+
+template <typename T, typename Layout>
+const T& Matrix<T, Layout>::const_iterator::operator*() const {
+	return (*_mat)[_pos];
+}
+
+template <typename T, typename Layout>
+const T& Matrix<T, Layout>::const_iterator::operator[](difference_type n) const {
+	return (*_mat)[_pos + n];
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator&
+Matrix<T, Layout>::const_iterator::operator++() { // prefix
 	++_pos;
 	return *this;
 }
 
-template <typename T>
-typename Matrix<T>::const_iterator Matrix<T>::const_iterator::operator++(
-  int) { // postfix
-	const_iterator res(_mat, _pos);
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator
+Matrix<T, Layout>::const_iterator::operator++(int) { // postfix
+	const_iterator res(*this);
 	++(*this);
 	return res;
 }
 
-template <typename T>
-typename Matrix<T>::const_iterator& Matrix<T>::const_iterator::operator--() { // prefix
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator&
+Matrix<T, Layout>::const_iterator::operator--() { // prefix
 	--_pos;
 	return *this;
 }
 
-template <typename T>
-typename Matrix<T>::const_iterator Matrix<T>::const_iterator::operator--(
-  int) { // postfix
-	const_iterator res(_mat, _pos);
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator
+Matrix<T, Layout>::const_iterator::operator--(int) { // postfix
+	const_iterator res(*this);
 	--(*this);
 	return res;
 }
 
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator&
+Matrix<T, Layout>::const_iterator::operator+=(difference_type n) {
+	_pos += n;
+	return *this;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator&
+Matrix<T, Layout>::const_iterator::operator-=(difference_type n) {
+	_pos -= n;
+	return *this;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator
+Matrix<T, Layout>::const_iterator::operator+(difference_type n) const {
+	return const_iterator(*this) += n;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator
+Matrix<T, Layout>::const_iterator::operator-(difference_type n) const {
+	return const_iterator(*this) -= n;
+}
+
+template <typename T, typename Layout>
+typename Matrix<T, Layout>::const_iterator::difference_type
+Matrix<T, Layout>::const_iterator::operator-(const const_iterator& rhs) const {
+	return static_cast<difference_type>(_pos) - static_cast<difference_type>(rhs._pos);
+}
+
 ////////////
 //  Misc  //
 ////////////
 
-template <typename T>
+template <typename T, typename Layout>
 std::ostream&
-operator<<(std::ostream& stream, const Matrix<T>& mat) {
+operator<<(std::ostream& stream, const Matrix<T, Layout>& mat) {
 	std::size_t count = 0;
 	for (auto const& it : mat) {
 		stream << std::setw(4) << it << ' ';
-		if (++count == mat.n) {
+		if (++count == mat.width) {
 			count = 0;
-			stream << std::endl;
+			stream << '\n'; // no flush per row
 		}
 	}
 	return stream;
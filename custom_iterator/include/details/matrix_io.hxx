@@ -0,0 +1,174 @@
+#pragma once
+
+#include <matrix_io.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace details {
+
+template <typename T>
+constexpr std::uint32_t
+kindCode() {
+	if constexpr (std::is_floating_point_v<T>)
+		return 'f';
+	else if constexpr (std::is_integral_v<T>)
+		return std::is_signed_v<T> ? 'i' : 'u';
+	else
+		return 'r';
+}
+
+template <typename Curve>
+constexpr std::uint32_t
+curveCode() {
+	if constexpr (std::is_same_v<Curve, hilbert::Curve>)
+		return 1;
+	else if constexpr (std::is_same_v<Curve, morton::Curve>)
+		return 2;
+	else if constexpr (std::is_same_v<Curve, graycode::Curve>)
+		return 3;
+	else
+		return 0;
+}
+
+template <typename Layout>
+struct LayoutCode {
+	static constexpr std::uint32_t value = 0; // RowMajor
+};
+
+//! Tiled: curve << 8 | tile order.
+template <typename Curve, unsigned TileOrder>
+struct LayoutCode<Tiled<Curve, TileOrder>> {
+	static_assert(curveCode<Curve>() != 0, "Unknown tile curve.");
+	static constexpr std::uint32_t value = curveCode<Curve>() << 8 | TileOrder;
+};
+
+//! @brief Identifier of a Layout stored in the header.
+template <typename Layout>
+constexpr std::uint32_t
+layoutCode() {
+	static_assert(std::is_same_v<Layout, RowMajor> || LayoutCode<Layout>::value != 0,
+	              "Unknown Matrix layout.");
+	return LayoutCode<Layout>::value;
+}
+
+//! Size of the writes (and of the header padding).
+constexpr std::size_t kWriteChunk = std::size_t(1) << 20;
+} // namespace details
+
+template <typename T, typename Layout>
+void
+save(const Matrix<T, Layout>& mat, const std::string& path) {
+	static_assert(std::is_trivially_copyable_v<T>, "Elements are written as bytes.");
+	MatrixHeader header{};
+	std::memcpy(header.magic, MatrixHeader::kMagic, sizeof(header.magic));
+	header.version = MatrixHeader::kVersion;
+	header.endian  = MatrixHeader::kEndian;
+	header.kind    = details::kindCode<T>();
+	header.size    = sizeof(T);
+	header.layout  = details::layoutCode<Layout>();
+	header.order   = mat.order;
+	header.width   = mat.width;
+	header.height  = mat.height;
+	header.count   = mat.data.size();
+	header.offset  = MatrixHeader::kOffset;
+
+	std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(path.c_str(), "wb"),
+	                                                     &std::fclose);
+	if (!file) throw std::runtime_error("Cannot create " + path);
+	// Unbuffered: the writes are already large.
+	std::setvbuf(file.get(), nullptr, _IONBF, 0);
+
+	char page[MatrixHeader::kOffset] = {};
+	std::memcpy(page, &header, sizeof(header));
+	bool ok           = std::fwrite(page, 1, sizeof(page), file.get()) == sizeof(page);
+	const char* bytes = reinterpret_cast<const char*>(mat.data.get());
+	std::size_t left  = mat.data.size() * sizeof(T);
+	while (ok && left > 0) {
+		const std::size_t chunk = left < details::kWriteChunk ? left : details::kWriteChunk;
+		ok = std::fwrite(bytes, 1, chunk, file.get()) == chunk;
+		bytes += chunk;
+		left -= chunk;
+	}
+	if (!ok || std::fclose(file.release()) != 0)
+		throw std::runtime_error("Cannot write " + path);
+}
+
+///////////////////
+//  MappedMatrix  //
+///////////////////
+
+template <typename T, typename Layout>
+MappedMatrix<T, Layout>::Mapping::Mapping(const std::string& path)
+  : address(MAP_FAILED)
+  , length(0) {
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw std::runtime_error("Cannot open " + path);
+	struct stat st;
+	if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+		length  = static_cast<std::size_t>(st.st_size);
+		address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+	}
+	::close(fd); // the mapping keeps the file
+	if (address == MAP_FAILED) throw std::runtime_error("Cannot map " + path);
+}
+
+template <typename T, typename Layout>
+MappedMatrix<T, Layout>::Mapping::~Mapping() {
+	::munmap(address, length);
+}
+
+template <typename T, typename Layout>
+const MatrixHeader&
+MappedMatrix<T, Layout>::check(const Mapping& mapping, const std::string& path) {
+	const auto& header = *static_cast<const MatrixHeader*>(mapping.address);
+	if (mapping.length < sizeof(MatrixHeader) ||
+	    std::memcmp(header.magic, MatrixHeader::kMagic, sizeof(header.magic)) != 0 ||
+	    header.version != MatrixHeader::kVersion ||
+	    header.endian != MatrixHeader::kEndian)
+		throw std::runtime_error(path + " is not a Matrix file");
+	if (header.kind != details::kindCode<T>() || header.size != sizeof(T))
+		throw std::runtime_error(path + " element type mismatch");
+	if (header.layout != details::layoutCode<Layout>())
+		throw std::runtime_error(path + " layout mismatch");
+	if (header.width == 0 || header.height == 0 || header.offset < sizeof(header) ||
+	    header.offset > mapping.length ||
+	    header.count != Layout::storage(header.width, header.height, header.order) ||
+	    header.offset % alignof(T) != 0 ||
+	    (mapping.length - header.offset) / sizeof(T) < header.count)
+		throw std::runtime_error(path + " is truncated or corrupted");
+	return header;
+}
+
+template <typename T, typename Layout>
+MappedMatrix<T, Layout>::MappedMatrix(const std::string& path)
+  : _mapping(path)
+  , _header(check(_mapping, path))
+  , _mat(matrix_view,
+         Vector<std::size_t>(_header.width, _header.height),
+         reinterpret_cast<T*>(static_cast<char*>(_mapping.address) + _header.offset)) {
+	if (_mat.order != _header.order) throw std::runtime_error(path + " order mismatch");
+}
+
+template <typename T, typename Layout>
+MappedMatrix<T, Layout>::~MappedMatrix() = default;
+
+template <typename T, typename Layout>
+const Matrix<T, Layout>&
+MappedMatrix<T, Layout>::matrix() const {
+	return _mat;
+}
+
+template <typename T, typename Layout>
+const MatrixHeader&
+MappedMatrix<T, Layout>::header() const {
+	return _header;
+}
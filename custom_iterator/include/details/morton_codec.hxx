@@ -0,0 +1,105 @@
+#pragma once
+
+#include <morton_codec.hpp>
+
+namespace morton {
+namespace details {
+
+//! @brief Spread the 32 bits of v on the even bits of a 64 bits word.
+constexpr std::uint64_t
+spread(std::uint64_t v) {
+	v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+	v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+	v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	v = (v | (v << 2)) & 0x3333333333333333ULL;
+	v = (v | (v << 1)) & 0x5555555555555555ULL;
+	return v;
+}
+
+//! @brief Compact the even bits of v on the 32 low bits.
+constexpr std::uint32_t
+compact(std::uint64_t v) {
+	v &= 0x5555555555555555ULL;
+	v = (v | (v >> 1)) & 0x3333333333333333ULL;
+	v = (v | (v >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+	v = (v | (v >> 4)) & 0x00FF00FF00FF00FFULL;
+	v = (v | (v >> 8)) & 0x0000FFFF0000FFFFULL;
+	v = (v | (v >> 16)) & 0x00000000FFFFFFFFULL;
+	return static_cast<std::uint32_t>(v);
+}
+
+inline std::uint64_t
+encodeScalar(std::uint32_t x, std::uint32_t y, unsigned) {
+	return spread(x) | (spread(y) << 1);
+}
+
+inline Vector<std::uint32_t>
+decodeScalar(std::uint64_t d, unsigned) {
+	return Vector<std::uint32_t>(compact(d), compact(d >> 1));
+}
+
+#if SNIPPETS_HAS_X86
+SNIPPETS_TARGET_BMI2 inline std::uint64_t
+encodeBMI2(std::uint32_t x, std::uint32_t y, unsigned) {
+	return _pdep_u64(x, 0x5555555555555555ULL) | _pdep_u64(y, 0xAAAAAAAAAAAAAAAAULL);
+}
+
+SNIPPETS_TARGET_BMI2 inline Vector<std::uint32_t>
+decodeBMI2(std::uint64_t d, unsigned) {
+	return Vector<std::uint32_t>(
+	  static_cast<std::uint32_t>(_pext_u64(d, 0x5555555555555555ULL)),
+	  static_cast<std::uint32_t>(_pext_u64(d, 0xAAAAAAAAAAAAAAAAULL)));
+}
+#endif
+} // namespace details
+
+inline std::uint64_t
+encode(Backend backend, std::uint32_t x, std::uint32_t y, unsigned order) {
+#if SNIPPETS_HAS_X86
+	if (backend == Backend::BMI2) return details::encodeBMI2(x, y, order);
+#endif
+	(void)backend;
+	return details::encodeScalar(x, y, order);
+}
+
+inline Vector<std::uint32_t>
+decode(Backend backend, std::uint64_t d, unsigned order) {
+#if SNIPPETS_HAS_X86
+	if (backend == Backend::BMI2) return details::decodeBMI2(d, order);
+#endif
+	(void)backend;
+	return details::decodeScalar(d, order);
+}
+
+inline std::uint64_t
+encode(std::uint32_t x, std::uint32_t y, unsigned order) {
+	return details::encodeScalar(x, y, order);
+}
+
+inline Vector<std::uint32_t>
+decode(std::uint64_t d, unsigned order) {
+	return details::decodeScalar(d, order);
+}
+
+inline void
+encodeBatch(const std::uint32_t* xs,
+            const std::uint32_t* ys,
+            std::uint64_t* out,
+            std::size_t count,
+            unsigned order) {
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = details::encodeScalar(xs[i], ys[i], order);
+}
+
+inline void
+decodeBatch(const std::uint64_t* ds,
+            std::uint32_t* xs,
+            std::uint32_t* ys,
+            std::size_t count,
+            unsigned) {
+	for (std::size_t i = 0; i < count; ++i) {
+		xs[i] = details::compact(ds[i]);
+		ys[i] = details::compact(ds[i] >> 1);
+	}
+}
+} // namespace morton
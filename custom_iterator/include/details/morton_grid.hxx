@@ -0,0 +1,112 @@
+#pragma once
+
+#include <morton_grid.hpp>
+
+namespace morton {
+namespace details {
+
+//! @brief Spread the order low bits of v, bit b on the bit b * D.
+template <std::size_t D>
+constexpr std::uint64_t
+spread(std::uint64_t v, unsigned order) {
+	if constexpr (D == 1) {
+		return v;
+	} else if constexpr (D == 2) {
+		return spread(v);
+	} else if constexpr (D == 3) {
+		v &= 0x1FFFFF; // 21 bits
+		v = (v | (v << 32)) & 0x001F00000000FFFFULL;
+		v = (v | (v << 16)) & 0x001F0000FF0000FFULL;
+		v = (v | (v << 8)) & 0x100F00F00F00F00FULL;
+		v = (v | (v << 4)) & 0x10C30C30C30C30C3ULL;
+		v = (v | (v << 2)) & 0x1249249249249249ULL;
+		return v;
+	} else {
+		std::uint64_t res = 0;
+		for (unsigned b = 0; b < order; ++b)
+			res |= ((v >> b) & 1) << (b * D);
+		return res;
+	}
+}
+
+//! @brief Compact the bits b * D of v on the order low bits.
+template <std::size_t D>
+constexpr std::uint32_t
+compact(std::uint64_t v, unsigned order) {
+	if constexpr (D == 1) {
+		return static_cast<std::uint32_t>(v);
+	} else if constexpr (D == 2) {
+		return compact(v);
+	} else if constexpr (D == 3) {
+		v &= 0x1249249249249249ULL;
+		v = (v | (v >> 2)) & 0x10C30C30C30C30C3ULL;
+		v = (v | (v >> 4)) & 0x100F00F00F00F00FULL;
+		v = (v | (v >> 8)) & 0x001F0000FF0000FFULL;
+		v = (v | (v >> 16)) & 0x001F00000000FFFFULL;
+		v = (v | (v >> 32)) & 0x1FFFFF;
+		return static_cast<std::uint32_t>(v);
+	} else {
+		std::uint32_t res = 0;
+		for (unsigned b = 0; b < order; ++b)
+			res |= static_cast<std::uint32_t>((v >> (b * D)) & 1) << b;
+		return res;
+	}
+}
+} // namespace details
+
+template <std::size_t D>
+std::uint64_t
+encode(const std::array<std::uint32_t, D>& p, unsigned order) {
+	std::uint64_t res = 0;
+	for (std::size_t i = 0; i < D; ++i)
+		res |= details::spread<D>(p[i], order) << i;
+	return res;
+}
+
+template <std::size_t D>
+std::array<std::uint32_t, D>
+decode(std::uint64_t d, unsigned order) {
+	std::array<std::uint32_t, D> res;
+	for (std::size_t i = 0; i < D; ++i)
+		res[i] = details::compact<D>(d >> i, order);
+	return res;
+}
+
+template <std::size_t D>
+void
+encodeBatch(const std::array<const std::uint32_t*, D>& coords,
+            std::uint64_t* out,
+            std::size_t count,
+            unsigned order) {
+	for (std::size_t j = 0; j < count; ++j) {
+		std::uint64_t res = 0;
+		for (std::size_t i = 0; i < D; ++i)
+			res |= details::spread<D>(coords[i][j], order) << i;
+		out[j] = res;
+	}
+}
+
+template <std::size_t D>
+void
+decodeBatch(const std::uint64_t* ds,
+            const std::array<std::uint32_t*, D>& coords,
+            std::size_t count,
+            unsigned order) {
+	for (std::size_t j = 0; j < count; ++j) {
+		for (std::size_t i = 0; i < D; ++i)
+			coords[i][j] = details::compact<D>(ds[j] >> i, order);
+	}
+}
+
+template <std::size_t D>
+std::uint64_t
+GridCurve<D>::encode(const std::array<std::uint32_t, D>& p, unsigned order) {
+	return morton::encode<D>(p, order);
+}
+
+template <std::size_t D>
+std::array<std::uint32_t, D>
+GridCurve<D>::decode(std::uint64_t d, unsigned order) {
+	return morton::decode<D>(d, order);
+}
+}
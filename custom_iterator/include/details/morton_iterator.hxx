@@ -0,0 +1,61 @@
+#pragma once
+
+#include <morton_codec.hpp>
+#include <morton_iterator.hpp>
+
+namespace morton {
+
+inline void
+Curve::seek(State& s, std::size_t pos, unsigned order) {
+	auto res = morton::decode(pos, order);
+	s.x      = res.x;
+	s.y      = res.y;
+}
+
+inline void
+Curve::next(State& s, std::size_t, unsigned) {
+	// Digits (x | y << 1) equal to 3 became 0, then the next one is incremented.
+	const std::size_t m    = s.x & s.y;
+	const std::size_t low  = (m ^ (m + 1)) >> 1; // trailing levels of digit 3
+	const std::size_t next = low + 1;            // level of the incremented digit
+	s.x &= ~low;
+	s.y &= ~low;
+	if (s.x & next) {
+		s.x ^= next;
+		s.y |= next;
+	} else {
+		s.x |= next;
+	}
+}
+
+inline void
+Curve::prev(State& s, std::size_t, unsigned) {
+	// Digits equal to 0 became 3, then the next one is decremented.
+	const std::size_t m    = ~(s.x | s.y);
+	const std::size_t low  = (m ^ (m + 1)) >> 1; // trailing levels of digit 0
+	const std::size_t next = low + 1;            // level of the decremented digit
+	s.x |= low;
+	s.y |= low;
+	if (s.x & next) {
+		s.x ^= next;
+	} else {
+		s.x |= next;
+		s.y ^= next;
+	}
+}
+
+inline std::uint64_t
+Curve::encode(std::uint32_t x, std::uint32_t y, unsigned order) {
+	return morton::encode(x, y, order);
+}
+
+inline Vector<std::uint32_t>
+Curve::decode(std::uint64_t d, unsigned order) {
+	return morton::decode(d, order);
+}
+
+inline Vector<std::size_t>
+Curve::block(unsigned k, unsigned) {
+	return Vector<std::size_t>(std::size_t(1) << k, std::size_t(1) << k);
+}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <parallel_for_curve.hpp>
+
+#include <algorithm>
+
+namespace details {
+inline std::size_t
+segmentSize(std::size_t size, unsigned workers) {
+	std::size_t target = size / (std::size_t(workers) * kSegmentsPerWorker);
+	if (target < kMinSegment) target = kMinSegment;
+	std::size_t res = 1;
+	while (res * 4 <= target)
+		res *= 4;
+	return res;
+}
+}
+
+template <typename T, typename Layout, typename Curve, typename F>
+void
+parallel_for_curve(Matrix<T, Layout>& mat, Curve, F&& fn, ThreadPool& pool) {
+	const std::size_t size    = mat.size();
+	const std::size_t segment = details::segmentSize(size, pool.size());
+	pool.run((size + segment - 1) / segment, [&](std::size_t i) {
+		const std::size_t last = std::min(size, (i + 1) * segment);
+		// Segment bounds are valid by construction: no check needed.
+		curve_iterator<T, Curve, Layout, Unchecked> it(mat, i * segment); // seek once
+		for (std::size_t d = i * segment; d < last; ++d, ++it)
+			fn(*it);
+	});
+}
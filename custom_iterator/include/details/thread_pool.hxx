@@ -0,0 +1,112 @@
+#pragma once
+
+#include <thread_pool.hpp>
+
+#include <algorithm>
+
+inline ThreadPool::ThreadPool(unsigned threads)
+  : _task(nullptr)
+  , _pending(0)
+  , _generation(0)
+  , _error(nullptr)
+  , _stop(false) {
+	threads = std::max(threads, 1u);
+	for (unsigned i = 0; i < threads; ++i)
+		_queues.emplace_back(new Queue());
+	for (unsigned i = 0; i < threads; ++i)
+		_threads.emplace_back(&ThreadPool::work, this, i);
+}
+
+inline ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_wake.notify_all();
+	for (auto& thread : _threads)
+		thread.join();
+}
+
+inline unsigned
+ThreadPool::size() const {
+	return static_cast<unsigned>(_threads.size());
+}
+
+inline void
+ThreadPool::run(std::size_t count, const std::function<void(std::size_t)>& task) {
+	if (count == 0) return;
+	std::lock_guard<std::mutex> guard(_run);
+	std::unique_lock<std::mutex> lock(_mutex);
+	_task    = &task;
+	_pending = count;
+	_error   = nullptr;
+	// Worker w get the block [w * count / size, (w + 1) * count / size).
+	const std::size_t workers = _queues.size();
+	for (std::size_t w = 0; w < workers; ++w) {
+		std::lock_guard<std::mutex> qlock(_queues[w]->mutex);
+		for (std::size_t i = w * count / workers; i < (w + 1) * count / workers; ++i)
+			_queues[w]->items.push_back(i);
+	}
+	++_generation;
+	_wake.notify_all();
+	_done.wait(lock, [this]() { return _pending == 0; });
+	_task = nullptr;
+	if (_error) std::rethrow_exception(_error);
+}
+
+inline ThreadPool&
+ThreadPool::global() {
+	static ThreadPool pool;
+	return pool;
+}
+
+inline void
+ThreadPool::work(unsigned id) {
+	std::size_t seen = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [&]() { return _stop || _generation != seen; });
+			if (_stop) return;
+			seen = _generation;
+		}
+		std::size_t item, done = 0;
+		std::exception_ptr error;
+		while (pop(id, item)) {
+			try {
+				(*_task)(item);
+			} catch (...) {
+				if (!error) error = std::current_exception();
+			}
+			++done;
+		}
+		if (done) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (error && !_error) _error = error;
+			if ((_pending -= done) == 0) _done.notify_all();
+		}
+	}
+}
+
+inline bool
+ThreadPool::pop(unsigned id, std::size_t& item) {
+	{
+		Queue& queue = *_queues[id];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.items.empty()) {
+			item = queue.items.front();
+			queue.items.pop_front();
+			return true;
+		}
+	}
+	for (std::size_t i = 1; i < _queues.size(); ++i) {
+		Queue& victim = *_queues[(id + i) % _queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.items.empty()) {
+			item = victim.items.back();
+			victim.items.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_dispatch.hpp"
+#include "matrix.hpp"
+
+//! @namespace graycode Gray code of the row major index of a 2^order x 2^order
+//! grid. Coordinates are 32 bits wide (i.e. order <= 32) and indices 64 bits.
+namespace graycode {
+//! @brief Gray code of the row major index of the cell (x, y).
+std::uint64_t encode(std::uint32_t x, std::uint32_t y, unsigned order);
+//! @brief Cell (x, y) of the Gray code d using the best backend of the CPU.
+Vector<std::uint32_t> decode(std::uint64_t d, unsigned order);
+
+//! @{
+//! @brief Same as above using a specific backend.
+//! Gray code decoding is a prefix XOR which has no pdep/pext formulation, so the
+//! BMI2 backend is the Scalar one.
+std::uint64_t encode(Backend backend, std::uint32_t x, std::uint32_t y, unsigned order);
+Vector<std::uint32_t> decode(Backend backend, std::uint64_t d, unsigned order);
+//! @}
+
+//! @{
+//! @brief Curve indices out[i] of the count cells (xs[i], ys[i]).
+//! Keys are processed by SIMD lanes using the best batch backend of the CPU.
+void encodeBatch(const std::uint32_t* xs,
+                 const std::uint32_t* ys,
+                 std::uint64_t* out,
+                 std::size_t count,
+                 unsigned order);
+//! @brief Cells (xs[i], ys[i]) of the count curve indices ds[i].
+void decodeBatch(const std::uint64_t* ds,
+                 std::uint32_t* xs,
+                 std::uint32_t* ys,
+                 std::size_t count,
+                 unsigned order);
+//! @}
+
+//! @{
+//! @brief Same as above using a specific backend (which must be supported by the
+//! CPU). Non SIMD backends loop over the single key functions.
+void encodeBatch(Backend backend,
+                 const std::uint32_t* xs,
+                 const std::uint32_t* ys,
+                 std::uint64_t* out,
+                 std::size_t count,
+                 unsigned order);
+void decodeBatch(Backend backend,
+                 const std::uint64_t* ds,
+                 std::uint32_t* xs,
+                 std::uint32_t* ys,
+                 std::size_t count,
+                 unsigned order);
+//! @}
+}
+
+#include "details/graycode_codec.hxx"
+#include "details/graycode_batch.hxx"
@@ -1,33 +1,29 @@
 #pragma once
 
+#include "curve_iterator.hpp"
+#include "graycode_codec.hpp"
 #include "matrix.hpp"
 
 namespace graycode {
-//! @class iterator_graycode 2D hilbert curve iterator.
-template <typename T>
-class iterator {
-	public:
-	iterator(Matrix<T>& mat, std::size_t pos = 0);
-	~iterator();
+//! @struct Curve Gray code curve policy of curve_iterator.
+//! Decoding is a handful of shifts so each step decode the new position.
+struct Curve {
+	struct State {
+		std::size_t x;
+		std::size_t y;
+	};
 
-	iterator<T> begin() const;
-	iterator<T> end() const;
-
-	bool operator==(const iterator& rhs) const;
-	bool operator!=(const iterator& rhs) const;
-	T& operator*();
-	iterator& operator++();   // prefix
-	iterator& operator--();   // prefix
-	iterator operator++(int); // postfix
-	iterator operator--(int); // postfix
-
-	std::size_t XYToBinary(Vector<std::size_t> vec) const;
-	Vector<std::size_t> BinaryToXY(std::size_t d) const;
-
-	private:
-	Matrix<T>& _mat;
-	std::size_t _pos;
+	static void seek(State& s, std::size_t pos, unsigned order);
+	static void next(State& s, std::size_t pos, unsigned order);
+	static void prev(State& s, std::size_t pos, unsigned order);
+	static std::uint64_t encode(std::uint32_t x, std::uint32_t y, unsigned order);
+	static Vector<std::uint32_t> decode(std::uint64_t d, unsigned order);
+	static Vector<std::size_t> block(unsigned k, unsigned order);
 };
+
+//! @class iterator 2D graycode curve iterator.
+template <typename T, typename Layout = RowMajor, typename Check = DefaultCheck>
+using iterator = curve_iterator<T, Curve, Layout, Check>;
 }
 
 #include "details/graycode_iterator.hxx"
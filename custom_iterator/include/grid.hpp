@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+
+//! @class Grid container (D dimensions array, e.g. a 3D volume).
+//! Elements are stored row major (axis 0 first, i.e. x then y then z), in a
+//! single cache line aligned allocation. Curve traversals are provided by
+//! grid_curve_iterator (e.g. hilbert::grid_iterator, morton::grid_iterator).
+template <typename T, std::size_t D>
+struct Grid {
+	static_assert(D > 0, "A Grid needs at least one dimension.");
+
+	using Point = std::array<std::size_t, D>;
+
+	//! Create a grid of n^D elements (any positive n).
+	//! @param[in] n size of the grid along each axis.
+	//! @param[in] value value use to initialize the grid.
+	Grid(std::size_t n, const T& value = 0);
+	//! Create a grid of extents[0] x ... x extents[D - 1] elements.
+	//! @param[in] extents size of the grid along each axis.
+	//! @param[in] value value use to initialize the grid.
+	Grid(const Point& extents, const T& value = 0);
+
+	//! @brief Access to the element of coordinates p.
+	T& operator()(const Point& p);
+	const T& operator()(const Point& p) const;
+
+	//! @brief Access to the element of row major index pos.
+	T& operator[](std::size_t pos);
+	const T& operator[](std::size_t pos) const;
+
+	//! @{
+	//! @brief Storage (row major) order.
+	T* begin();
+	T* end();
+	const T* begin() const;
+	const T* end() const;
+	T* get();
+	const T* get() const;
+	//! @}
+
+	//! @brief Number of elements (i.e. product of the extents).
+	std::size_t size() const;
+
+	//! @brief Row major index of the element of coordinates p.
+	std::size_t offset(const Point& p) const;
+
+	const Point extents;
+	const std::size_t n;  // side of a cube (max of the extents otherwise)
+	const unsigned order; // log2(n) rounded up, i.e. order of the curves covering it
+
+	private:
+	//! @brief Smallest k such as 2^k >= n, throw if n is zero or if the curve
+	//! indices of order k do not fit in 64 bits.
+	static unsigned log2(std::size_t n);
+	static std::size_t max(const Point& extents);
+	static Point cube(std::size_t n);
+
+	Point _strides;
+	std::vector<T, AlignedAllocator<T, 64>> _values;
+};
+
+#include "details/grid.hxx"
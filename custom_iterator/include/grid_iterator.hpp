@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "check_policy.hpp"
+#include "curve_blocks.hpp"
+#include "grid.hpp"
+
+//! @class grid_curve_iterator D dimensions space filling curve iterator.
+//! Same as curve_iterator on a Grid, the curve is a compile time policy
+//! (e.g. hilbert::GridCurve<D>, morton::GridCurve<D>):
+//! @code
+//! struct Curve {
+//!   static std::uint64_t encode(const std::array<std::uint32_t, D>& p,
+//!                               unsigned order);
+//!   static std::array<std::uint32_t, D> decode(std::uint64_t d, unsigned order);
+//! };
+//! @endcode
+//! The 2^(D k) consecutive indices starting at a multiple of 2^(D k) must cover
+//! an aligned cube of side 2^k, so grids which are not a power of two cube are
+//! walked like the rectangle matrices: empty blocks are skipped at once and
+//! jumps count the cells of the blocks.
+//! Each step decodes the curve index (the codecs are unrolled for D).
+template <typename T, std::size_t D, typename Curve, typename Check = DefaultCheck>
+class grid_curve_iterator {
+	public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type        = T;
+	using difference_type   = std::ptrdiff_t;
+	using pointer           = T*;
+	using reference         = T&;
+	using Point             = typename Grid<T, D>::Point;
+
+	grid_curve_iterator();
+	grid_curve_iterator(Grid<T, D>& grid, std::size_t pos = 0);
+
+	grid_curve_iterator begin() const;
+	grid_curve_iterator end() const;
+
+	bool operator==(const grid_curve_iterator& rhs) const;
+	bool operator!=(const grid_curve_iterator& rhs) const;
+	bool operator<(const grid_curve_iterator& rhs) const;
+	bool operator>(const grid_curve_iterator& rhs) const;
+	bool operator<=(const grid_curve_iterator& rhs) const;
+	bool operator>=(const grid_curve_iterator& rhs) const;
+	T& operator*() const;
+	T& operator[](difference_type n) const;
+	grid_curve_iterator& operator++();   // prefix
+	grid_curve_iterator& operator--();   // prefix
+	grid_curve_iterator operator++(int); // postfix
+	grid_curve_iterator operator--(int); // postfix
+	grid_curve_iterator& operator+=(difference_type n);
+	grid_curve_iterator& operator-=(difference_type n);
+	grid_curve_iterator operator+(difference_type n) const;
+	grid_curve_iterator operator-(difference_type n) const;
+	friend grid_curve_iterator operator+(difference_type n,
+	                                     const grid_curve_iterator& it) {
+		return it + n;
+	}
+	difference_type operator-(const grid_curve_iterator& rhs) const;
+
+	//! @brief Coordinates of the current cell.
+	Point point() const;
+
+	//! @{
+	//! @brief Conversions between a cell of the grid and its curve index.
+	std::uint64_t PointToBinary(const Point& p) const;
+	Point BinaryToPoint(std::uint64_t d) const;
+	//! @}
+
+	private:
+	using Cell = std::array<std::uint32_t, D>;
+
+	void seek();
+	std::uint64_t select(std::size_t pos) const;
+
+	//! @{
+	//! @brief Box policy of CurveBlocks<D> (the grid cells).
+	template <std::size_t>
+	friend struct CurveBlocks;
+	Cell decode(std::uint64_t d) const;
+	std::size_t count(const Cell& cell, unsigned k) const;
+	bool inside(const Cell& cell) const;
+	void move(Cell& cell, std::uint64_t d, unsigned k, bool forward) const;
+	//! @}
+
+	Grid<T, D>* _grid;
+	std::size_t _pos;     // traversal position in [0, size]
+	std::uint64_t _index; // curve index of _pos
+	unsigned _order;
+	bool _full; // power of two cube (i.e. no cell to skip)
+	Cell _cell;
+};
+
+#include "details/grid_iterator.hxx"
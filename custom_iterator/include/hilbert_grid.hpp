@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "check_policy.hpp"
+#include "grid.hpp"
+#include "grid_iterator.hpp"
+#include "hilbert_codec.hpp"
+#include "morton_grid.hpp"
+
+//! Hilbert encoding of a 2^order grid of D dimensions (Skilling's transpose
+//! algorithm, the loops over the axes are unrolled for D). Indices are 64
+//! bits (i.e. D * order <= 64). For D = 2 the curve is the one of
+//! hilbert::encode.
+namespace hilbert {
+//! @{
+//! @brief Conversions between a cell and its curve index.
+template <std::size_t D>
+std::uint64_t encode(const std::array<std::uint32_t, D>& p, unsigned order);
+template <std::size_t D>
+std::array<std::uint32_t, D> decode(std::uint64_t d, unsigned order);
+//! @}
+
+//! @{
+//! @brief Curve indices out[i] of the count cells (coords[0][i], ...) and
+//! reverse (one array per axis, like the 2D batches).
+template <std::size_t D>
+void encodeBatch(const std::array<const std::uint32_t*, D>& coords,
+                 std::uint64_t* out,
+                 std::size_t count,
+                 unsigned order);
+template <std::size_t D>
+void decodeBatch(const std::uint64_t* ds,
+                 const std::array<std::uint32_t*, D>& coords,
+                 std::size_t count,
+                 unsigned order);
+//! @}
+
+//! @struct GridCurve Hilbert curve policy of grid_curve_iterator.
+template <std::size_t D>
+struct GridCurve {
+	static std::uint64_t encode(const std::array<std::uint32_t, D>& p, unsigned order);
+	static std::array<std::uint32_t, D> decode(std::uint64_t d, unsigned order);
+};
+
+//! @class grid_iterator D dimensions hilbert curve iterator.
+template <typename T, std::size_t D, typename Check = DefaultCheck>
+using grid_iterator = grid_curve_iterator<T, D, GridCurve<D>, Check>;
+}
+
+#include "details/hilbert_grid.hxx"
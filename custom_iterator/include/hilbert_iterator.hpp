@@ -1,33 +1,44 @@
 #pragma once
 
+#include <cstdint>
+
+#include "curve_iterator.hpp"
+#include "hilbert_codec.hpp"
 #include "matrix.hpp"
 
 namespace hilbert {
-//! @class iterator_hilbert 2D hilbert curve iterator.
-template <typename T>
-class iterator {
-	public:
-	iterator(Matrix<T>& mat, std::size_t pos = 0);
-	~iterator();
-
-	iterator<T> begin() const;
-	iterator<T> end() const;
-
-	bool operator==(const iterator& rhs) const;
-	bool operator!=(const iterator& rhs) const;
-	T& operator*();
-	iterator& operator++();   // prefix
-	iterator& operator--();   // prefix
-	iterator operator++(int); // postfix
-	iterator operator--(int); // postfix
-
-	std::size_t XYToBinary(Vector<std::size_t> vec) const;
-	Vector<std::size_t> BinaryToXY(std::size_t d) const;
+//! @struct Curve Hilbert curve policy of curve_iterator.
+//! The cursor keep the current cell (x, y) and the curve orientation of each
+//! level, so next/prev only update the levels whose digit changed
+//! (amortized O(1)).
+struct Curve {
+	struct State {
+		std::size_t x;
+		std::size_t y;
+		// Orientation of the curve entering each level (2 bits per level).
+		// bit 0: x/y swap, bit 1: x/y complement.
+		std::uint64_t states;
+	};
+
+	static void seek(State& s, std::size_t pos, unsigned order);
+	static void next(State& s, std::size_t pos, unsigned order);
+	static void prev(State& s, std::size_t pos, unsigned order);
+	static std::uint64_t encode(std::uint32_t x, std::uint32_t y, unsigned order);
+	static Vector<std::uint32_t> decode(std::uint64_t d, unsigned order);
+	static Vector<std::size_t> block(unsigned k, unsigned order);
 
 	private:
-	Matrix<T>& _mat;
-	std::size_t _pos;
+	//! @brief Recompute (x, y) bits and orientations of levels [0, level].
+	static void update(State& s, std::size_t pos, unsigned level);
 };
+
+//! @class iterator 2D hilbert curve iterator.
+template <typename T, typename Layout = RowMajor, typename Check = DefaultCheck>
+using iterator = curve_iterator<T, Curve, Layout, Check>;
+
+//! @brief Matrix layout storing each 2^TileOrder x 2^TileOrder tile in hilbert order.
+template <unsigned TileOrder = 5>
+using TiledLayout = Tiled<Curve, TileOrder>;
 }
 
 #include "details/hilbert_iterator.hxx"
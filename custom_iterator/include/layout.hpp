@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! @struct RowMajor Matrix layout storing each row contiguously.
+struct RowMajor {
+	//! Rows are contiguous so Matrix::row() is available.
+	static constexpr bool contiguousRows = true;
+
+	//! @brief Number of elements stored for a width x height matrix.
+	//! order is log2 of the smallest power of two >= max(width, height).
+	static std::size_t storage(std::size_t width, std::size_t height, unsigned order);
+
+	//! @brief Index in the storage of the cell (x, y) of a width x height matrix.
+	static std::size_t offset(std::size_t x,
+	                          std::size_t y,
+	                          std::size_t width,
+	                          unsigned order);
+};
+
+//! @struct Tiled Matrix layout storing square tiles of 2^TileOrder x 2^TileOrder
+//! cells contiguously (tiles are in row major order), each tile storing its cells
+//! in Curve order (e.g. hilbert::Curve, morton::Curve).
+//! Neighbor cells are thus on the same cache lines and pages (default tile
+//! 32 x 32 i.e. 4 KiB of int).
+//! Matrix smaller than a tile use the first cells of the tile curve (both Morton
+//! and Hilbert curves fill the square [0, 2^k)^2 first) so there is no padding
+//! for power of two squares, otherwise the last row and column of tiles are
+//! padded to whole tiles.
+template <typename Curve, unsigned TileOrder = 5>
+struct Tiled {
+	static_assert(TileOrder <= 8, "Tile offsets are stored on 16 bits.");
+	static constexpr bool contiguousRows = false;
+
+	static std::size_t storage(std::size_t width, std::size_t height, unsigned order);
+	static std::size_t offset(std::size_t x,
+	                          std::size_t y,
+	                          std::size_t width,
+	                          unsigned order);
+
+	private:
+	//! @brief Offset in the tile of each cell (y << TileOrder | x).
+	static std::vector<std::uint16_t> makeLut();
+	static inline const std::vector<std::uint16_t> _lut = makeLut();
+};
+
+#include "details/layout.hxx"
@@ -1,7 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <ostream>
 #include <vector>
 
+#include "aligned_allocator.hpp"
+#include "check_policy.hpp"
+#include "layout.hpp"
+
 //! @class Matrix container (2D Vector).
 template <typename T>
 struct Vector {
@@ -13,29 +20,69 @@ struct Vector {
 	T y;
 };
 
+//! @struct view_t Tag of the Matrix (and Buffer) constructors making a view on
+//! external storage, so a literal value (e.g. 0) never selects them.
+struct view_t {
+	explicit view_t() = default;
+};
+inline constexpr view_t matrix_view{};
+
 //! @class Matrix container (2D Matrix).
-template <typename T>
+//! Layout is the physical order of the elements in memory (e.g. RowMajor,
+//! hilbert::TiledLayout<>), accessors and iterators do not depend on it.
+//! Iterators follow the DefaultCheck policy (see check_policy.hpp).
+template <typename T, typename Layout = RowMajor>
 struct Matrix {
 	//! Create a container of n^2 elements aka matrix of n x n elments.
-	//! @param[in] n must be a power of two.
+	//! @param[in] n size of the matrix (any positive value).
 	//! @param[in] value value use to initialize the matrix.
 	Matrix(std::size_t n, const T& value = 0);
+	//! Create a matrix of width x height elements (no padding to a power of two).
+	//! @param[in] extents width (x) and height (y) of the matrix.
+	//! @param[in] value value use to initialize the matrix.
+	Matrix(Vector<std::size_t> extents, const T& value = 0);
+	//! Create a view on external storage (e.g. a mapped file, see matrix_io.hpp).
+	//! @param[in] extents width (x) and height (y) of the matrix.
+	//! @param[in] values Layout::storage() elements in Layout order, not owned
+	//! (they must outlive the matrix). A copy of the view owns its elements.
+	Matrix(view_t, Vector<std::size_t> extents, T* values);
 	~Matrix();
 
 	//! @{
 	class const_iterator {
 		public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const T*;
+		using reference         = const T&;
+
+		const_iterator();
 		const_iterator(const Matrix& mat, std::size_t pos = 0);
 
-		bool operator==(const const_iterator& rhs);
-		bool operator!=(const const_iterator& rhs);
-		const T& operator*();
+		bool operator==(const const_iterator& rhs) const;
+		bool operator!=(const const_iterator& rhs) const;
+		bool operator<(const const_iterator& rhs) const;
+		bool operator>(const const_iterator& rhs) const;
+		bool operator<=(const const_iterator& rhs) const;
+		bool operator>=(const const_iterator& rhs) const;
+		const T& operator*() const;
+		const T& operator[](difference_type n) const;
 		const_iterator& operator++();   // prefix
 		const_iterator operator++(int); // postfix
 		const_iterator& operator--();   // prefix
 		const_iterator operator--(int); // postfix
+		const_iterator& operator+=(difference_type n);
+		const_iterator& operator-=(difference_type n);
+		const_iterator operator+(difference_type n) const;
+		const_iterator operator-(difference_type n) const;
+		difference_type operator-(const const_iterator& rhs) const;
+		friend const_iterator operator+(difference_type n, const const_iterator& it) {
+			return it + n;
+		}
+
 		private:
-		const Matrix& _mat;
+		const Matrix* _mat;
 		std::size_t _pos;
 	};
 
@@ -46,17 +93,36 @@ struct Matrix {
 	//! @{
 	class iterator {
 		public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = T*;
+		using reference         = T&;
+
+		iterator();
 		iterator(Matrix& mat, std::size_t pos = 0);
 
-		bool operator==(const iterator& rhs);
-		bool operator!=(const iterator& rhs);
-		T& operator*();
+		bool operator==(const iterator& rhs) const;
+		bool operator!=(const iterator& rhs) const;
+		bool operator<(const iterator& rhs) const;
+		bool operator>(const iterator& rhs) const;
+		bool operator<=(const iterator& rhs) const;
+		bool operator>=(const iterator& rhs) const;
+		T& operator*() const;
+		T& operator[](difference_type n) const;
 		iterator& operator++();   // prefix
 		iterator operator++(int); // postfix
 		iterator& operator--();   // prefix
 		iterator operator--(int); // postfix
+		iterator& operator+=(difference_type n);
+		iterator& operator-=(difference_type n);
+		iterator operator+(difference_type n) const;
+		iterator operator-(difference_type n) const;
+		difference_type operator-(const iterator& rhs) const;
+		friend iterator operator+(difference_type n, const iterator& it) { return it + n; }
+
 		private:
-		Matrix& _mat;
+		Matrix* _mat;
 		std::size_t _pos;
 	};
 
@@ -64,13 +130,83 @@ struct Matrix {
 	iterator end();
 	//! @}
 
-	const std::size_t n;
-	std::vector<std::vector<T>> data; // row major
+	//! @class Buffer Contiguous cache line aligned storage (in Layout order).
+	//! Only one allocation of n^2 elements, operator[] return the row y (a
+	//! pointer for RowMajor) so legacy code reading data[y][x] still works.
+	class Buffer {
+		public:
+		//! Alignment of the first element (i.e. cache line size).
+		static constexpr std::size_t alignment = 64;
+
+		//! @class Row Proxy on a row of a non RowMajor layout.
+		template <typename U, typename B>
+		class Row {
+			public:
+			Row(B& buffer, std::size_t y);
+			U& operator[](std::size_t x) const;
+
+			private:
+			B& _buffer;
+			std::size_t _y;
+		};
+
+		Buffer(std::size_t width, std::size_t height, unsigned order, const T& value);
+		//! View on external storage (not owned).
+		Buffer(view_t, std::size_t width, std::size_t height, unsigned order, T* values);
+		//! Deep copy (i.e. the copy of a view owns its elements).
+		Buffer(const Buffer& rhs);
+		Buffer(Buffer&& rhs) noexcept = default;
+		Buffer& operator=(const Buffer&) = delete;
 
+		auto operator[](std::size_t y);
+		auto operator[](std::size_t y) const;
+
+		//! @brief Access to the underlying flat array (in Layout order).
+		T* get();
+		const T* get() const;
+
+		//! @brief Number of elements of the flat array (may include the Layout
+		//! padding, i.e. size() >= width * height).
+		std::size_t size() const;
+
+		//! @brief Access to the element (x, y).
+		T& at(std::size_t x, std::size_t y);
+		const T& at(std::size_t x, std::size_t y) const;
+
+		private:
+		std::size_t _width;
+		unsigned _order;
+		std::vector<T, AlignedAllocator<T, alignment>> _values; // empty for a view
+		T* _data;
+		std::size_t _size;
+	};
+
+	//! @brief Access to the element (x, y) (i.e. column x of row y).
+	T& operator()(std::size_t x, std::size_t y);
+	const T& operator()(std::size_t x, std::size_t y) const;
+
+	//! @brief Access to the element of row major index pos (i.e. pos = y * width + x).
+	T& operator[](std::size_t pos);
+	const T& operator[](std::size_t pos) const;
+
+	//! @brief Pointer on the first element of the row y (RowMajor layout only).
+	T* row(std::size_t y);
+	const T* row(std::size_t y) const;
+
+	const std::size_t width;
+	const std::size_t height;
+	const std::size_t n;  // side of a square matrix (max(width, height) otherwise)
+	const unsigned order; // log2(n) rounded up, i.e. order of the curves covering it
+	Buffer data;          // Layout order
+
+	//! @brief Number of elements (i.e. width * height).
 	std::size_t size() const;
+
+	//! @brief Smallest k such as 2^k >= n, throw if n is zero.
+	static unsigned log2(std::size_t n);
 };
 
-template <typename T>
-std::ostream& operator<<(std::ostream& stream, const Matrix<T>& mat);
+template <typename T, typename Layout>
+std::ostream& operator<<(std::ostream& stream, const Matrix<T, Layout>& mat);
 
 #include "details/matrix.hxx"
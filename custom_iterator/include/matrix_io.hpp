@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "matrix.hpp"
+
+namespace hilbert {
+struct Curve;
+}
+namespace morton {
+struct Curve;
+}
+namespace graycode {
+struct Curve;
+}
+
+//! @struct MatrixHeader Header of the binary Matrix files (native endianness).
+//! The elements follow at offset (page aligned, so they can be mapped), in
+//! Layout order (padding included), i.e. the Matrix storage as is.
+struct MatrixHeader {
+	static constexpr char kMagic[8]         = {'S', 'N', 'P', 'M', 'A', 'T', 'R', 'X'};
+	static constexpr std::uint32_t kVersion = 1;
+	static constexpr std::uint32_t kEndian  = 0x01020304;
+	static constexpr std::uint64_t kOffset  = 4096;
+
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t endian;
+	std::uint32_t kind;   // element kind: 'i', 'u', 'f' or 'r' (raw bytes)
+	std::uint32_t size;   // sizeof(T)
+	std::uint32_t layout; // see details::layoutCode()
+	std::uint32_t order;
+	std::uint64_t width;
+	std::uint64_t height;
+	std::uint64_t count;  // number of elements stored
+	std::uint64_t offset; // of the first element
+};
+
+//! @brief Write mat to the file path (replaced): the header then the storage
+//! by large writes. T must be trivially copyable. Throw std::runtime_error on
+//! I/O error.
+template <typename T, typename Layout>
+void save(const Matrix<T, Layout>& mat, const std::string& path);
+
+//! @class MappedMatrix Read-only Matrix view of a file written by save(), the
+//! file is mapped (no read, no copy): pages are loaded on first access.
+//! Element type and layout must be the ones of the file (std::runtime_error
+//! otherwise). A copy of matrix() is an owning (writable) Matrix.
+template <typename T, typename Layout = RowMajor>
+class MappedMatrix {
+	public:
+	explicit MappedMatrix(const std::string& path);
+	~MappedMatrix();
+	MappedMatrix(const MappedMatrix&) = delete;
+	MappedMatrix& operator=(const MappedMatrix&) = delete;
+
+	const Matrix<T, Layout>& matrix() const;
+	const MatrixHeader& header() const;
+
+	private:
+	//! @class Mapping Whole file mapping (unmapped by the destructor).
+	struct Mapping {
+		explicit Mapping(const std::string& path);
+		~Mapping();
+		Mapping(const Mapping&) = delete;
+		Mapping& operator=(const Mapping&) = delete;
+
+		void* address;
+		std::size_t length;
+	};
+
+	//! @brief Header of the mapping, throw if it does not match T and Layout.
+	static const MatrixHeader& check(const Mapping& mapping, const std::string& path);
+
+	Mapping _mapping;
+	const MatrixHeader& _header;
+	const Matrix<T, Layout> _mat;
+};
+
+#include "details/matrix_io.hxx"
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_dispatch.hpp"
+#include "matrix.hpp"
+
+//! @namespace morton Morton (Z-order) encoding of a 2^order x 2^order grid
+//! (x on the even bits, y on the odd bits). Coordinates are 32 bits wide
+//! (i.e. order <= 32) and curve indices 64 bits.
+namespace morton {
+//! @{
+//! @brief Curve index of the cell (x, y) and reverse using the Scalar spread on
+//! purpose: it is a few shifts and masks, so no CPU detection is done per call
+//! (the curve iterators call these on each step). Use the Backend overloads for
+//! pdep/pext.
+std::uint64_t encode(std::uint32_t x, std::uint32_t y, unsigned order);
+Vector<std::uint32_t> decode(std::uint64_t d, unsigned order);
+//! @}
+
+//! @{
+//! @brief Same as above using a specific backend.
+//! Bit interleaving needs no table, so all backends but BMI2 (pdep/pext) use the
+//! Scalar magic numbers spread.
+std::uint64_t encode(Backend backend, std::uint32_t x, std::uint32_t y, unsigned order);
+Vector<std::uint32_t> decode(Backend backend, std::uint64_t d, unsigned order);
+//! @}
+
+//! @{
+//! @brief Curve indices out[i] of the count cells (xs[i], ys[i]) and reverse.
+//! The Scalar loop is branch free and left to the compiler auto-vectorizer.
+void encodeBatch(const std::uint32_t* xs,
+                 const std::uint32_t* ys,
+                 std::uint64_t* out,
+                 std::size_t count,
+                 unsigned order);
+void decodeBatch(const std::uint64_t* ds,
+                 std::uint32_t* xs,
+                 std::uint32_t* ys,
+                 std::size_t count,
+                 unsigned order);
+//! @}
+}
+
+#include "details/morton_codec.hxx"
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "check_policy.hpp"
+#include "grid.hpp"
+#include "grid_iterator.hpp"
+#include "morton_codec.hpp"
+
+//! Morton (Z-order) encoding of a 2^order grid of D dimensions: bit b of the
+//! axis i is the bit b * D + i of the curve index (i.e. the 2D encoding for
+//! D = 2). Indices are 64 bits (i.e. D * order <= 64).
+namespace morton {
+//! @{
+//! @brief Conversions between a cell and its curve index (the bit spreading is
+//! specialized for D = 2 and D = 3 and unrolled for the others).
+template <std::size_t D>
+std::uint64_t encode(const std::array<std::uint32_t, D>& p, unsigned order);
+template <std::size_t D>
+std::array<std::uint32_t, D> decode(std::uint64_t d, unsigned order);
+//! @}
+
+//! @{
+//! @brief Curve indices out[i] of the count cells (coords[0][i], ...) and
+//! reverse (one array per axis, like the 2D batches).
+template <std::size_t D>
+void encodeBatch(const std::array<const std::uint32_t*, D>& coords,
+                 std::uint64_t* out,
+                 std::size_t count,
+                 unsigned order);
+template <std::size_t D>
+void decodeBatch(const std::uint64_t* ds,
+                 const std::array<std::uint32_t*, D>& coords,
+                 std::size_t count,
+                 unsigned order);
+//! @}
+
+//! @struct GridCurve Morton curve policy of grid_curve_iterator.
+template <std::size_t D>
+struct GridCurve {
+	static std::uint64_t encode(const std::array<std::uint32_t, D>& p, unsigned order);
+	static std::array<std::uint32_t, D> decode(std::uint64_t d, unsigned order);
+};
+
+//! @class grid_iterator D dimensions Morton (Z-order) curve iterator.
+template <typename T, std::size_t D, typename Check = DefaultCheck>
+using grid_iterator = grid_curve_iterator<T, D, GridCurve<D>, Check>;
+}
+
+#include "details/morton_grid.hxx"
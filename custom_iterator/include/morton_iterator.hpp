@@ -0,0 +1,33 @@
+#pragma once
+
+#include "curve_iterator.hpp"
+#include "matrix.hpp"
+#include "morton_codec.hpp"
+
+namespace morton {
+//! @struct Curve Morton (Z-order) curve policy of curve_iterator.
+//! next/prev are O(1): the trailing levels whose digit wrap are reset at once.
+struct Curve {
+	struct State {
+		std::size_t x;
+		std::size_t y;
+	};
+
+	static void seek(State& s, std::size_t pos, unsigned order);
+	static void next(State& s, std::size_t pos, unsigned order);
+	static void prev(State& s, std::size_t pos, unsigned order);
+	static std::uint64_t encode(std::uint32_t x, std::uint32_t y, unsigned order);
+	static Vector<std::uint32_t> decode(std::uint64_t d, unsigned order);
+	static Vector<std::size_t> block(unsigned k, unsigned order);
+};
+
+//! @class iterator 2D Morton (Z-order) curve iterator.
+template <typename T, typename Layout = RowMajor, typename Check = DefaultCheck>
+using iterator = curve_iterator<T, Curve, Layout, Check>;
+
+//! @brief Matrix layout storing each 2^TileOrder x 2^TileOrder tile in Morton order.
+template <unsigned TileOrder = 5>
+using TiledLayout = Tiled<Curve, TileOrder>;
+}
+
+#include "details/morton_iterator.hxx"
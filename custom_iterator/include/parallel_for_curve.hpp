@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+#include "curve_iterator.hpp"
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+
+namespace details {
+//! Minimum number of cells of a segment (i.e. 16 KiB of int) so the scheduling
+//! cost stays negligible.
+constexpr std::size_t kMinSegment = 4096;
+//! Number of segments per worker, so idle workers have something to steal.
+constexpr std::size_t kSegmentsPerWorker = 8;
+
+//! @brief Number of cells of each segment of a traversal of size cells.
+//! Segments are a power of 4 cells, so on a Hilbert or Morton curve each one
+//! is a full square sub-block of a power of two square matrix.
+std::size_t segmentSize(std::size_t size, unsigned workers);
+}
+
+//! @brief Call fn(value) on each element of mat in Curve order (e.g.
+//! hilbert::Curve{}) using the pool workers.
+//! The curve index range [0, n^2) is cut into contiguous segments, each worker
+//! walking a segment with its own incremental curve_iterator so the cells of a
+//! segment are spatially close. The order of fn calls between segments is
+//! unspecified.
+template <typename T, typename Layout, typename Curve, typename F>
+void parallel_for_curve(Matrix<T, Layout>& mat,
+                        Curve curve,
+                        F&& fn,
+                        ThreadPool& pool = ThreadPool::global());
+
+#include "details/parallel_for_curve.hxx"
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! @class ThreadPool fork/join pool of work stealing workers.
+//! run() gives each worker a contiguous block of the task indices: a worker
+//! pops its own block from the front (i.e. in order) and, once it is empty,
+//! steals from the back of the other blocks (i.e. the indices the owner will
+//! reach last).
+class ThreadPool {
+	public:
+	//! @param[in] threads number of workers (at least one).
+	explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	//! @brief Number of workers.
+	unsigned size() const;
+
+	//! @brief Call task(i) for each i in [0, count) and wait for completion.
+	//! The first exception thrown by a task is rethrown (the other tasks still
+	//! run). Must not be called from a task.
+	void run(std::size_t count, const std::function<void(std::size_t)>& task);
+
+	//! @brief Pool shared by the whole process (one worker per core).
+	static ThreadPool& global();
+
+	private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<std::size_t> items;
+	};
+
+	void work(unsigned id);
+	//! @brief Pop a task from the worker queue, else steal one.
+	bool pop(unsigned id, std::size_t& item);
+
+	std::vector<std::unique_ptr<Queue>> _queues;
+	std::vector<std::thread> _threads;
+	std::mutex _run; // one run() at a time
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+	const std::function<void(std::size_t)>* _task;
+	std::size_t _pending;
+	std::size_t _generation;
+	std::exception_ptr _error;
+	bool _stop;
+};
+
+#include "details/thread_pool.hxx"
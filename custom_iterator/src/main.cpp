@@ -1,20 +1,572 @@
+#include <algorithm>
 #include <cmath>
+#include <execution>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <random>
 #include <stdexcept>
 #include <vector>
 
+#include <curve_ranges.hpp>
+#include <graycode_codec.hpp>
 #include <graycode_iterator.hpp>
+#include <grid.hpp>
+#include <hilbert_codec.hpp>
+#include <hilbert_grid.hpp>
 #include <hilbert_iterator.hpp>
 #include <matrix.hpp>
+#include <matrix_io.hpp>
+#include <morton_codec.hpp>
+#include <morton_grid.hpp>
+#include <morton_iterator.hpp>
+#include <parallel_for_curve.hpp>
+
+//! @brief Check the incremental curve iterator against BinaryToXY().
+template <typename Curve>
+void
+checkCurve(std::size_t n) {
+	Matrix<int> mat(n);
+	curve_iterator<int, Curve> it(mat);
+	std::size_t d = 0;
+	for (auto cur = it.begin(); cur != it.end(); ++cur, ++d) {
+		auto xy = it.BinaryToXY(d);
+		if (&*cur != &mat(xy.x, xy.y)) throw std::runtime_error("curve++ mismatch");
+	}
+	for (auto cur = it.end(); cur != it.begin();) {
+		auto xy = it.BinaryToXY(--d);
+		if (&*--cur != &mat(xy.x, xy.y)) throw std::runtime_error("curve-- mismatch");
+	}
+}
+
+//! @brief Check random access jumps and the parallel algorithms.
+template <typename Curve>
+void
+checkRandomAccess(std::size_t n) {
+	Matrix<int> mat(n);
+	curve_iterator<int, Curve> it(mat);
+	if (std::distance(it.begin(), it.end()) != static_cast<std::ptrdiff_t>(mat.size()))
+		throw std::runtime_error("curve distance mismatch");
+	for (std::size_t d = 0; d < mat.size(); d += 3) {
+		auto xy = it.BinaryToXY(d);
+		if (&*(it.begin() + d) != &mat(xy.x, xy.y) || &it.begin()[d] != &mat(xy.x, xy.y) ||
+		    &*(it.end() - (mat.size() - d)) != &mat(xy.x, xy.y))
+			throw std::runtime_error("curve jump mismatch");
+	}
+
+	std::for_each(std::execution::par, it.begin(), it.end(), [&](int& v) {
+		v = static_cast<int>(&v - mat.data.get());
+	});
+	for (std::size_t i = 0; i < mat.size(); ++i) {
+		if (mat.data.get()[i] != static_cast<int>(i))
+			throw std::runtime_error("curve parallel for_each mismatch");
+	}
+
+	std::sort(std::execution::par, mat.begin(), mat.end(), std::greater<int>());
+	if (mat.end() - mat.begin() != static_cast<std::ptrdiff_t>(mat.size()) ||
+	    !std::is_sorted(mat.begin(), mat.end(), std::greater<int>()))
+		throw std::runtime_error("matrix sort mismatch");
+}
+
+//! @brief Check the Checked policy throws on misuse and Unchecked iterators
+//! walk the same cells.
+template <typename Curve>
+void
+checkPolicies(std::size_t n) {
+	Matrix<int> mat(n), other(n);
+	curve_iterator<int, Curve, RowMajor, Checked> checked(mat);
+	curve_iterator<int, Curve, RowMajor, Unchecked> unchecked(mat);
+	for (std::size_t d = 0; d < mat.size(); ++d) {
+		if (&*(checked.begin() + d) != &*(unchecked.begin() + d))
+			throw std::runtime_error("check policy mismatch");
+	}
+	int thrown = 0;
+	try {
+		*checked.end();
+	} catch (const std::range_error&) {
+		++thrown;
+	}
+	try {
+		(void)(checked.begin() == decltype(checked)(other));
+	} catch (const std::runtime_error&) {
+		++thrown;
+	}
+	if (thrown != 2) throw std::runtime_error("checked iterator did not throw");
+}
+
+//! @brief Check parallel_for_curve visits each element once and forwards the
+//! kernel exceptions.
+template <typename Curve>
+void
+checkParallel(std::size_t n, ThreadPool& pool) {
+	Matrix<int> mat(n);
+	curve_iterator<int, Curve> it(mat);
+	std::iota(it.begin(), it.end(), 0);
+	parallel_for_curve(mat, Curve{}, [](int& v) { v += 1; }, pool);
+	for (std::size_t d = 0; d < mat.size(); ++d) {
+		if (it.begin()[d] != static_cast<int>(d) + 1)
+			throw std::runtime_error("parallel_for_curve mismatch");
+	}
+
+	bool thrown = false;
+	try {
+		parallel_for_curve(
+		  mat,
+		  Curve{},
+		  [](int& v) {
+			  if (v == 42) throw std::runtime_error("kernel failure");
+		  },
+		  pool);
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	if (thrown != (mat.size() > 42))
+		throw std::runtime_error("parallel_for_curve exception mismatch");
+}
+
+//! @brief Check the traversal of a width x height matrix walks the cells of the
+//! covering square curve which are in the matrix, and only them.
+template <typename Curve, typename Layout>
+void
+checkRectangle(std::size_t width, std::size_t height, ThreadPool& pool) {
+	Matrix<int, Layout> mat(Vector<std::size_t>(width, height));
+	std::vector<const int*> cells;
+	std::vector<bool> used(mat.data.size(), false);
+	for (std::uint64_t d = 0; d < (std::uint64_t(1) << (2 * mat.order)); ++d) {
+		const auto xy = Curve::decode(d, mat.order);
+		if (xy.x >= width || xy.y >= height) continue;
+		const int* cell = &mat(xy.x, xy.y);
+		if (used[cell - mat.data.get()])
+			throw std::runtime_error("rectangle layout is not injective");
+		used[cell - mat.data.get()] = true;
+		cells.push_back(cell);
+	}
+	if (cells.size() != mat.size()) throw std::runtime_error("rectangle size mismatch");
+
+	curve_iterator<int, Curve, Layout> it(mat);
+	if (it.end() - it.begin() != static_cast<std::ptrdiff_t>(mat.size()))
+		throw std::runtime_error("rectangle distance mismatch");
+	std::size_t d = 0;
+	for (auto cur = it.begin(); cur != it.end(); ++cur, ++d) {
+		if (&*cur != cells[d] || &it.begin()[d] != cells[d])
+			throw std::runtime_error("rectangle curve++ mismatch");
+	}
+	for (auto cur = it.end(); cur != it.begin();) {
+		if (&*--cur != cells[--d]) throw std::runtime_error("rectangle curve-- mismatch");
+	}
+
+	parallel_for_curve(mat, Curve{}, [](int& v) { v += 1; }, pool);
+	for (auto cell : cells) {
+		if (*cell != 1) throw std::runtime_error("rectangle parallel_for_curve mismatch");
+	}
+}
+
+//! @brief Check a Layout is a bijection and accessors agree with each other.
+template <typename Layout>
+void
+checkLayout(std::size_t n) {
+	Matrix<int, Layout> mat(n);
+	for (std::size_t y = 0; y < n; ++y) {
+		for (std::size_t x = 0; x < n; ++x)
+			mat(x, y) = static_cast<int>(y * n + x);
+	}
+	std::vector<bool> seen(mat.size(), false);
+	for (std::size_t i = 0; i < mat.size(); ++i)
+		seen[mat.data.get()[i]] = true;
+	if (std::count(seen.begin(), seen.end(), false) != 0)
+		throw std::runtime_error("layout is not a bijection");
+
+	int expected = 0;
+	for (const auto& it : mat) {
+		if (it != expected++) throw std::runtime_error("layout row major mismatch");
+	}
+	if (&mat.data[n - 1][n / 2] != &mat(n / 2, n - 1))
+		throw std::runtime_error("layout data[y][x] mismatch");
+	std::iota(hilbert::iterator<int, Layout>(mat).begin(),
+	          hilbert::iterator<int, Layout>(mat).end(),
+	          0);
+	hilbert::iterator<int, Layout> it(mat);
+	for (std::size_t y = 0; y < n; ++y) {
+		for (std::size_t x = 0; x < n; ++x) {
+			if (std::size_t(mat(x, y)) != it.XYToBinary(Vector<std::size_t>(x, y)))
+				throw std::runtime_error("layout curve traversal mismatch");
+		}
+	}
+}
+
+//! @brief Check all codec backends return the same results for 64 bits indices.
+void
+checkCodecs() {
+	std::vector<Backend> backends = {Backend::Scalar, Backend::Table};
+	if (hasBMI2()) backends.push_back(Backend::BMI2);
+
+	std::mt19937_64 gen(42);
+	for (unsigned order = 0; order <= 32; ++order) {
+		const std::uint64_t mask = (std::uint64_t(1) << order) - 1;
+		for (int i = 0; i < 1000; ++i) {
+			const std::uint32_t x = gen() & mask;
+			const std::uint32_t y = gen() & mask;
+			const std::uint64_t h = hilbert::encode(Backend::Scalar, x, y, order);
+			const std::uint64_t g = graycode::encode(x, y, order);
+			const std::uint64_t m = morton::encode(x, y, order);
+			for (auto backend : backends) {
+				auto mxy = morton::decode(backend, m, order);
+				if (morton::encode(backend, x, y, order) != m || mxy.x != x || mxy.y != y)
+					throw std::runtime_error("morton codec mismatch");
+				auto hxy = hilbert::decode(backend, h, order);
+				auto gxy = graycode::decode(backend, g, order);
+				if (hilbert::encode(backend, x, y, order) != h || hxy.x != x || hxy.y != y)
+					throw std::runtime_error("hilbert codec mismatch");
+				if (graycode::encode(backend, x, y, order) != g || gxy.x != x || gxy.y != y)
+					throw std::runtime_error("graycode codec mismatch");
+			}
+		}
+	}
+}
+
+//! @brief Check batch conversions against the single key functions.
+void
+checkBatches() {
+	std::vector<Backend> backends = {Backend::Scalar, Backend::Table};
+	if (hasBMI2()) backends.push_back(Backend::BMI2);
+	if (hasAVX2()) backends.push_back(Backend::AVX2);
+	if (hasAVX512()) backends.push_back(Backend::AVX512);
+
+	const std::size_t count = 1000; // not a multiple of the SIMD width
+	std::vector<std::uint32_t> xs(count), ys(count), rxs(count), rys(count);
+	std::vector<std::uint64_t> hs(count), gs(count);
+	std::mt19937_64 gen(42);
+	for (unsigned order = 0; order <= 32; ++order) {
+		const std::uint64_t mask = (std::uint64_t(1) << order) - 1;
+		for (std::size_t i = 0; i < count; ++i) {
+			xs[i] = gen() & mask;
+			ys[i] = gen() & mask;
+		}
+		for (auto backend : backends) {
+			hilbert::encodeBatch(backend, xs.data(), ys.data(), hs.data(), count, order);
+			graycode::encodeBatch(backend, xs.data(), ys.data(), gs.data(), count, order);
+			for (std::size_t i = 0; i < count; ++i) {
+				if (hs[i] != hilbert::encode(xs[i], ys[i], order))
+					throw std::runtime_error("hilbert batch encode mismatch");
+				if (gs[i] != graycode::encode(xs[i], ys[i], order))
+					throw std::runtime_error("graycode batch encode mismatch");
+			}
+			hilbert::decodeBatch(backend, hs.data(), rxs.data(), rys.data(), count, order);
+			if (rxs != xs || rys != ys)
+				throw std::runtime_error("hilbert batch decode mismatch");
+			graycode::decodeBatch(backend, gs.data(), rxs.data(), rys.data(), count, order);
+			if (rxs != xs || rys != ys)
+				throw std::runtime_error("graycode batch decode mismatch");
+		}
+		morton::encodeBatch(xs.data(), ys.data(), hs.data(), count, order);
+		for (std::size_t i = 0; i < count; ++i) {
+			if (hs[i] != morton::encode(xs[i], ys[i], order))
+				throw std::runtime_error("morton batch encode mismatch");
+		}
+		morton::decodeBatch(hs.data(), rxs.data(), rys.data(), count, order);
+		if (rxs != xs || rys != ys)
+			throw std::runtime_error("morton batch decode mismatch");
+	}
+}
+
+//! @brief Check the D dimensions codecs are bijections (single and batch) and
+//! the hilbert curve is continuous (consecutive cells are neighbors).
+template <std::size_t D>
+void
+checkGridCodecs(unsigned order) {
+	const std::uint64_t count = std::uint64_t(1) << (D * order);
+	std::vector<std::uint32_t> coords[D], rcoords[D];
+	std::array<const std::uint32_t*, D> in;
+	std::array<std::uint32_t*, D> out;
+	for (std::size_t i = 0; i < D; ++i) {
+		coords[i].resize(count);
+		rcoords[i].resize(count);
+		in[i]  = coords[i].data();
+		out[i] = rcoords[i].data();
+	}
+	std::vector<std::uint64_t> hs(count), ms(count);
+	for (std::uint64_t d = 0; d < count; ++d) {
+		const auto h = hilbert::decode<D>(d, order);
+		const auto m = morton::decode<D>(d, order);
+		if (hilbert::encode<D>(h, order) != d || morton::encode<D>(m, order) != d)
+			throw std::runtime_error("grid codec mismatch");
+		if (d > 0) {
+			const auto prev  = hilbert::decode<D>(d - 1, order);
+			std::uint32_t dist = 0;
+			for (std::size_t i = 0; i < D; ++i)
+				dist += h[i] > prev[i] ? h[i] - prev[i] : prev[i] - h[i];
+			if (dist != 1) throw std::runtime_error("grid hilbert curve is not continuous");
+		}
+		if constexpr (D == 2) {
+			if (hilbert::encode(h[0], h[1], order) != d ||
+			    morton::encode(m[0], m[1], order) != d)
+				throw std::runtime_error("grid codec does not match the 2D one");
+		}
+		for (std::size_t i = 0; i < D; ++i)
+			coords[i][d] = h[i];
+	}
+	hilbert::encodeBatch(in, hs.data(), count, order);
+	morton::encodeBatch(in, ms.data(), count, order);
+	for (std::uint64_t d = 0; d < count; ++d) {
+		if (hs[d] != d || ms[d] != morton::encode<D>(hilbert::decode<D>(d, order), order))
+			throw std::runtime_error("grid batch encode mismatch");
+	}
+	hilbert::decodeBatch(hs.data(), out, count, order);
+	for (std::size_t i = 0; i < D; ++i) {
+		if (rcoords[i] != coords[i]) throw std::runtime_error("grid batch decode mismatch");
+	}
+	morton::decodeBatch(ms.data(), out, count, order);
+	for (std::size_t i = 0; i < D; ++i) {
+		if (rcoords[i] != coords[i]) throw std::runtime_error("grid batch decode mismatch");
+	}
+}
+
+//! @brief Check the traversal of a Grid walks each of its cells once, in the
+//! order of the curve of the covering cube.
+template <typename Curve, std::size_t D>
+void
+checkGrid(const typename Grid<int, D>::Point& extents) {
+	Grid<int, D> grid(extents);
+	std::vector<const int*> cells;
+	for (std::uint64_t d = 0; d < (std::uint64_t(1) << (D * grid.order)); ++d) {
+		const auto cell = Curve::decode(d, grid.order);
+		typename Grid<int, D>::Point p;
+		bool inside = true;
+		for (std::size_t i = 0; i < D; ++i) {
+			p[i]   = cell[i];
+			inside = inside && cell[i] < extents[i];
+		}
+		if (inside) cells.push_back(&grid(p));
+	}
+	if (cells.size() != grid.size()) throw std::runtime_error("grid size mismatch");
+
+	grid_curve_iterator<int, D, Curve> it(grid);
+	if (it.end() - it.begin() != static_cast<std::ptrdiff_t>(grid.size()))
+		throw std::runtime_error("grid distance mismatch");
+	std::size_t d = 0;
+	for (auto cur = it.begin(); cur != it.end(); ++cur, ++d) {
+		*cur += 1;
+		if (&*cur != cells[d] || &it.begin()[d] != cells[d] ||
+		    it.BinaryToPoint(it.PointToBinary(cur.point())) != cur.point())
+			throw std::runtime_error("grid curve++ mismatch");
+	}
+	for (auto cur = it.end(); cur != it.begin();) {
+		if (&*--cur != cells[--d]) throw std::runtime_error("grid curve-- mismatch");
+	}
+	if (std::any_of(grid.begin(), grid.end(), [](int v) { return v != 1; }))
+		throw std::runtime_error("grid cell not visited once");
+}
+
+//! @brief Check a saved matrix is mapped back as is, and mismatching element
+//! types or layouts are rejected.
+template <typename Layout>
+void
+checkMatrixIO(std::size_t width, std::size_t height) {
+	const auto path =
+	  (std::filesystem::temp_directory_path() / "custom_iterator_matrix.bin").string();
+	Matrix<int, Layout> mat(Vector<std::size_t>(width, height));
+	std::iota(mat.data.get(), mat.data.get() + mat.data.size(), -7);
+	save(mat, path);
+	{
+		MappedMatrix<int, Layout> mapped(path);
+		const Matrix<int, Layout>& view = mapped.matrix();
+		if (view.width != width || view.height != height ||
+		    !std::equal(mat.begin(), mat.end(), view.begin(), view.end()))
+			throw std::runtime_error("mapped matrix mismatch");
+		const auto address = reinterpret_cast<std::uintptr_t>(view.data.get());
+		if (address % Matrix<int>::Buffer::alignment)
+			throw std::runtime_error("mapped matrix is not aligned");
+
+		Matrix<int, Layout> copy(view); // owning, writable
+		copy(0, 0) = 42;
+		if (view(0, 0) != mat(0, 0) || copy.data.get() == view.data.get())
+			throw std::runtime_error("mapped matrix copy mismatch");
+	}
+	bool rejected = false;
+	try {
+		MappedMatrix<unsigned, Layout> mapped(path);
+	} catch (const std::runtime_error&) {
+		rejected = true;
+	}
+	try {
+		MappedMatrix<int, hilbert::TiledLayout<3>> mapped(path);
+		rejected = false;
+	} catch (const std::runtime_error&) {
+	}
+	std::filesystem::remove(path);
+	if (!rejected) throw std::runtime_error("mapped matrix mismatch not detected");
+}
+
+//! @brief Check curve_ranges() covers exactly the rectangles with the fewest
+//! intervals, and the bounded covers contain them, against a full scan.
+template <typename Curve>
+void
+checkRanges(unsigned order) {
+	const std::uint32_t side = std::uint32_t(1) << order;
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<std::uint32_t> coord(0, side - 1);
+	for (int i = 0; i < 50; ++i) {
+		auto a = Vector<std::uint32_t>(coord(gen), coord(gen));
+		auto b = Vector<std::uint32_t>(coord(gen), coord(gen));
+		const auto min = Vector<std::uint32_t>(std::min(a.x, b.x), std::min(a.y, b.y));
+		const auto max = Vector<std::uint32_t>(std::max(a.x, b.x), std::max(a.y, b.y));
+		auto inside    = [&](std::uint64_t d) {
+			   const auto xy = Curve::decode(d, order);
+			   return xy.x >= min.x && xy.x <= max.x && xy.y >= min.y && xy.y <= max.y;
+		};
+
+		// Exact cover: the intervals of the full scan.
+		std::vector<CurveRange> scan;
+		for (std::uint64_t d = 0; d < std::uint64_t(side) * side; ++d) {
+			if (!inside(d)) continue;
+			if (!scan.empty() && scan.back().last + 1 == d)
+				scan.back().last = d;
+			else
+				scan.push_back({d, d});
+		}
+		const auto exact = curve_ranges<Curve>(min, max, order);
+		if (exact.size() != scan.size() ||
+		    !std::equal(exact.begin(),
+		                exact.end(),
+		                scan.begin(),
+		                [](const CurveRange& lhs, const CurveRange& rhs) {
+			                return lhs.first == rhs.first && lhs.last == rhs.last;
+		                }))
+			throw std::runtime_error("curve_ranges exact cover mismatch");
+
+		const auto bounded = curve_ranges<Curve>(min, max, order, 3);
+		if (bounded.size() > 3 || bounded.front().first != exact.front().first ||
+		    bounded.back().last != exact.back().last)
+			throw std::runtime_error("curve_ranges bounded cover mismatch");
+		for (const auto& range : exact) {
+			const bool covered =
+			  std::any_of(bounded.begin(), bounded.end(), [&](const CurveRange& r) {
+				  return r.first <= range.first && range.last <= r.last;
+			  });
+			if (!covered) throw std::runtime_error("curve_ranges bounded cover mismatch");
+		}
+	}
+	const auto whole = curve_ranges<Curve>(
+	  Vector<std::uint32_t>(0, 0), Vector<std::uint32_t>(side - 1, side - 1), order);
+	if (whole.size() != 1 || whole[0].last != std::uint64_t(side) * side - 1)
+		throw std::runtime_error("curve_ranges whole square mismatch");
+}
 
 int
 main() {
+	checkCodecs();
+	checkBatches();
+	for (std::size_t n = 1; n <= 64; n *= 2) {
+		checkCurve<hilbert::Curve>(n);
+		checkCurve<graycode::Curve>(n);
+		checkCurve<morton::Curve>(n);
+		checkPolicies<hilbert::Curve>(n);
+		checkPolicies<graycode::Curve>(n);
+		checkPolicies<morton::Curve>(n);
+		checkRandomAccess<hilbert::Curve>(n);
+		checkRandomAccess<graycode::Curve>(n);
+		checkRandomAccess<morton::Curve>(n);
+		checkLayout<RowMajor>(n);
+		checkLayout<morton::TiledLayout<>>(n);
+		checkLayout<hilbert::TiledLayout<>>(n);
+		checkLayout<hilbert::TiledLayout<2>>(n);
+	}
+
+	ThreadPool pool(4);
+	for (auto extents : {Vector<std::size_t>(3, 5),
+	                     Vector<std::size_t>(1, 7),
+	                     Vector<std::size_t>(37, 2),
+	                     Vector<std::size_t>(300, 170)}) {
+		const std::size_t w = extents.x, h = extents.y;
+		checkRectangle<hilbert::Curve, RowMajor>(w, h, pool);
+		checkRectangle<graycode::Curve, RowMajor>(w, h, pool);
+		checkRectangle<morton::Curve, RowMajor>(w, h, pool);
+		checkRectangle<hilbert::Curve, hilbert::TiledLayout<>>(w, h, pool);
+		checkRectangle<morton::Curve, morton::TiledLayout<2>>(h, w, pool);
+	}
+	for (unsigned order = 0; order <= 3; ++order) {
+		checkGridCodecs<1>(order);
+		checkGridCodecs<2>(order);
+		checkGridCodecs<3>(order);
+		checkGridCodecs<4>(order);
+	}
+	checkGridCodecs<5>(2);
+	for (std::size_t n : {1, 2, 8, 16}) {
+		checkGrid<hilbert::GridCurve<3>, 3>({n, n, n});
+		checkGrid<morton::GridCurve<3>, 3>({n, n, n});
+	}
+	checkGrid<hilbert::GridCurve<3>, 3>({3, 5, 7});
+	checkGrid<morton::GridCurve<3>, 3>({3, 5, 7});
+	checkGrid<hilbert::GridCurve<3>, 3>({20, 1, 33});
+	checkGrid<hilbert::GridCurve<2>, 2>({37, 2});
+	checkGrid<morton::GridCurve<4>, 4>({3, 4, 5, 2});
+	for (std::size_t axis = 0; axis < 3; ++axis) { // an empty axis is rejected
+		Grid<int, 3>::Point extents{5, 5, 5};
+		extents[axis] = 0;
+		bool thrown   = false;
+		try {
+			Grid<int, 3> grid(extents);
+		} catch (const std::runtime_error&) {
+			thrown = true;
+		}
+		if (!thrown) throw std::runtime_error("grid accepted an empty axis");
+	}
+	checkGrid<hilbert::GridCurve<4>, 4>({3, 4, 5, 2});
+	for (unsigned order = 0; order <= 6; order += 3) {
+		checkRanges<hilbert::Curve>(order);
+		checkRanges<morton::Curve>(order);
+		checkRanges<graycode::Curve>(order);
+	}
+	const auto all = curve_ranges<hilbert::Curve>(
+	  Vector<std::uint32_t>(0, 0), Vector<std::uint32_t>(~0u, ~0u), 32);
+	if (all.size() != 1 || all[0].first != 0 || all[0].last != ~std::uint64_t(0))
+		throw std::runtime_error("curve_ranges order 32 mismatch");
+	// Budgeted descent: a border rectangle of order 32 (about 2^34 exact
+	// intervals) in at most 16 intervals, from its first to its last cell.
+	for (unsigned order : {16u, 32u}) {
+		const std::uint32_t last = std::uint32_t((std::uint64_t(1) << order) - 2);
+		const Vector<std::uint32_t> min(1, 1), max(last, last);
+		const auto ranges = curve_ranges<hilbert::Curve>(min, max, order, 16);
+		std::uint64_t first = ~std::uint64_t(0), end = 0;
+		const Vector<std::uint32_t> corners[] = {min, max, {1, last}, {last, 1}};
+		for (auto xy : corners) {
+			const std::uint64_t d = hilbert::Curve::encode(xy.x, xy.y, order);
+			first                 = std::min(first, d);
+			end                   = std::max(end, d);
+			if (std::none_of(ranges.begin(), ranges.end(), [d](const CurveRange& r) {
+				    return r.first <= d && d <= r.last;
+			    }))
+				throw std::runtime_error("curve_ranges budgeted cover mismatch");
+		}
+		if (ranges.empty() || ranges.size() > 16 || ranges.front().first > first ||
+		    ranges.back().last < end)
+			throw std::runtime_error("curve_ranges budgeted cover mismatch");
+	}
+	// A literal value never selects the view constructor.
+	Matrix<double> zeros(Vector<std::size_t>(4, 3), 0);
+	Matrix<float> ones(Vector<std::size_t>(4, 3), 1);
+	if (zeros.size() != 12 || zeros(3, 2) != 0.0 || ones(3, 2) != 1.0f)
+		throw std::runtime_error("matrix value constructor mismatch");
+	int values[6] = {0, 1, 2, 3, 4, 5};
+	Matrix<int> view(matrix_view, Vector<std::size_t>(3, 2), values);
+	if (&view(2, 1) != values + 5) throw std::runtime_error("matrix view mismatch");
+	checkMatrixIO<RowMajor>(300, 170);
+	checkMatrixIO<RowMajor>(1, 1);
+	checkMatrixIO<morton::TiledLayout<>>(37, 2);
+	checkMatrixIO<hilbert::TiledLayout<>>(300, 170);
+	for (std::size_t n = 1; n <= 512; n *= 8) {
+		checkParallel<hilbert::Curve>(n, pool);
+		checkParallel<graycode::Curve>(n, pool);
+		checkParallel<morton::Curve>(n, pool);
+	}
+
 	const std::size_t n = (1 << 2);
 	Matrix<int> foo(n); // 8x8 Matrix
 	std::cout << "foo n: " << foo.n << std::endl;
 	std::cout << "foo size: " << foo.size() << std::endl;
+	if (&foo(1, 2) != &foo.data[2][1] || foo.row(2) + 1 != &foo(1, 2))
+		throw std::runtime_error("Matrix accessors mismatch");
 
 	{
 		std::iota(std::begin(hilbert::iterator<int>(foo)),
@@ -53,4 +605,11 @@ main() {
 			}
 		}
 	}
+
+	{
+		std::iota(std::begin(morton::iterator<int>(foo)),
+		          std::end(morton::iterator<int>(foo)),
+		          0);
+		std::cout << "morton curve:" << std::endl << foo << std::endl;
+	}
 }
@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <find_tuple.hpp>
+#include <tuple_finder.hpp>
+
+#include "measure.hpp"
+
+// Repeated queries of random value tuples on the same std::list<int>:
+// find_tuple (index of the values, one pass on the list per query) against
+// tuple_finder (index of the list built once, no allocation per query).
+// Half of the tuples have a missing last value.
+// Then the same queries on a std::vector<int> with find_tuple and
+// find_tuple_parallel.
+// usage: FindTupleBench [inputs] [queries] [tuple size] [threads]
+
+using bench::measure;
+
+int
+main(int argc, char* argv[]) {
+	const int count   = argc > 1 ? std::atoi(argv[1]) : 200000;
+	const int queries = argc > 2 ? std::atoi(argv[2]) : 1000;
+	const int size    = argc > 3 ? std::atoi(argv[3]) : 8;
+	const unsigned threads =
+	  argc > 4 ? std::atoi(argv[4]) : std::thread::hardware_concurrency();
+
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> value(0, count / 4);
+	std::list<int> inputs;
+	for (int i = 0; i < count; ++i)
+		inputs.push_back(value(gen));
+	std::vector<std::vector<int>> tuples(queries, std::vector<int>(size));
+	for (std::size_t i = 0; i < tuples.size(); ++i) {
+		for (auto& v : tuples[i])
+			v = value(gen);
+		if (i % 2) tuples[i].back() = count; // missing
+	}
+
+	std::size_t found = 0;
+	double time       = measure([&]() {
+		for (const auto& t : tuples)
+			found += find_tuple(inputs.begin(), inputs.end(), t.begin(), t.end()).size();
+	});
+	std::cout << "inputs: " << count << ", queries: " << queries
+	          << ", tuple size: " << size << std::endl;
+	std::cout << "engine, time (us/query)" << std::endl;
+	std::cout << "find_tuple, " << time / queries / 1e3 << " (" << found << ")"
+	          << std::endl;
+
+	found = 0;
+	std::vector<std::list<int>::iterator> out(size);
+	time = measure([&]() {
+		tuple_finder<std::list<int>::iterator> finder(inputs.begin(), inputs.end());
+		for (const auto& t : tuples)
+			found += finder.find(t.begin(), t.end(), out.begin()) ? size : 0;
+	});
+	std::cout << "tuple_finder (index included), " << time / queries / 1e3 << " ("
+	          << found << ")" << std::endl;
+
+	found = 0;
+	tuple_finder<std::list<int>::iterator> finder(inputs.begin(), inputs.end());
+	time = measure([&]() {
+		for (const auto& t : tuples)
+			found += finder.find(t.begin(), t.end(), out.begin()) ? size : 0;
+	});
+	std::cout << "tuple_finder (query only), " << time / queries / 1e3 << " (" << found
+	          << ")" << std::endl;
+
+	std::vector<int> vec(inputs.begin(), inputs.end());
+	found = 0;
+	time  = measure([&]() {
+		for (const auto& t : tuples)
+			found += find_tuple(vec.begin(), vec.end(), t.begin(), t.end()).size();
+	});
+	std::cout << "find_tuple (vector), " << time / queries / 1e3 << " (" << found << ")"
+	          << std::endl;
+
+	found = 0;
+	time  = measure([&]() {
+		for (const auto& t : tuples)
+			found +=
+			  find_tuple_parallel(vec.begin(), vec.end(), t.begin(), t.end(), threads).size();
+	});
+	std::cout << "find_tuple_parallel (vector, " << threads << " threads), "
+	          << time / queries / 1e3 << " (" << found << ")" << std::endl;
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <find_tuple.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace details {
+
+template <typename T, typename = void>
+struct is_hashable : std::false_type {};
+template <typename T>
+struct is_hashable<T, decltype(void(std::hash<T>()(std::declval<const T&>())))>
+  : std::true_type {};
+
+template <typename T, typename = void>
+struct is_less_comparable : std::false_type {};
+template <typename T>
+struct is_less_comparable<
+  T,
+  decltype(void(std::declval<const T&>() < std::declval<const T&>()))>
+  : std::true_type {};
+
+struct LinearTag {};
+struct SortTag {};
+struct HashTag {};
+
+//! @brief Matching engine of find_tuple for the input and value types.
+template <typename Input, typename Value>
+using Engine = std::conditional_t<
+  !std::is_same<Input, Value>::value,
+  LinearTag,
+  std::conditional_t<
+    is_hashable<Input>::value,
+    HashTag,
+    std::conditional_t<is_less_comparable<Input>::value, SortTag, LinearTag>>>;
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+//! @brief Original engine: search each value in the remaining positions.
+template <class InputIterator, class ValueIterator>
+std::vector<InputIterator>
+findTuple(InputIterator first,
+          InputIterator last,
+          ValueIterator valFirst,
+          ValueIterator valLast,
+          LinearTag) {
+	std::vector<InputIterator> inputs(std::distance(first, last));
+	std::iota(inputs.begin(), inputs.end(), first);
+
+	std::vector<InputIterator> result;
+	result.reserve(std::distance(valFirst, valLast));
+
+	// Find first element equal to v, remove it from inputs and add it to res.
+	// If there is none, v is missing and so is the tuple.
+	for (; valFirst != valLast; ++valFirst) {
+		auto it = std::find_if(inputs.begin(), inputs.end(), [&valFirst](InputIterator in) {
+			return *in == *valFirst;
+		});
+		if (it == inputs.end()) return std::vector<InputIterator>();
+		result.push_back(*it);
+		inputs.erase(it);
+	}
+	return result;
+}
+
+//! @brief Hash engine: the values are indexed once (value -> queue of the
+//! value indices still to match), then each input is matched against the
+//! index in O(1). The scan stops once every value is matched.
+template <class InputIterator, class ValueIterator>
+std::vector<InputIterator>
+findTuple(InputIterator first,
+          InputIterator last,
+          ValueIterator valFirst,
+          ValueIterator valLast,
+          HashTag) {
+	using Value = typename std::iterator_traits<InputIterator>::value_type;
+	struct Queue {
+		std::size_t head; // next value index to match
+		std::size_t tail; // last value index
+	};
+
+	// Queues are linked lists of the value indices (in order) through next.
+	std::unordered_map<Value, Queue> index;
+	std::vector<std::size_t> next;
+	std::size_t count = 0;
+	for (; valFirst != valLast; ++valFirst, ++count) {
+		next.push_back(npos);
+		auto res = index.emplace(*valFirst, Queue{count, count});
+		if (!res.second) res.first->second.tail = next[res.first->second.tail] = count;
+	}
+
+	std::vector<InputIterator> result(count, last);
+	std::size_t missing = count;
+	for (; first != last && missing != 0; ++first) {
+		auto it = index.find(*first);
+		if (it == index.end() || it->second.head == npos) continue;
+		result[it->second.head] = first;
+		it->second.head         = next[it->second.head];
+		--missing;
+	}
+	if (missing != 0) result.clear();
+	return result;
+}
+
+//! @brief Sort engine: same as the hash engine using a sorted index of the
+//! values (i.e. a binary search per input), equivalent values are equal.
+template <class InputIterator, class ValueIterator>
+std::vector<InputIterator>
+findTuple(InputIterator first,
+          InputIterator last,
+          ValueIterator valFirst,
+          ValueIterator valLast,
+          SortTag) {
+	using Value = typename std::iterator_traits<InputIterator>::value_type;
+	std::vector<Value> values(valFirst, valLast);
+	const std::size_t count = values.size();
+
+	// order: value indices sorted by value (then by index), head[i]: next
+	// position in order to match for the group of equal values starting at i.
+	std::vector<std::size_t> order(count), head(count);
+	auto less = [&values](std::size_t a, std::size_t b) { return values[a] < values[b]; };
+	auto lower = [&values](std::size_t a, const Value& v) { return values[a] < v; };
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), less);
+	std::iota(head.begin(), head.end(), 0);
+
+	std::vector<InputIterator> result(count, last);
+	std::size_t missing = count;
+	for (; first != last && missing != 0; ++first) {
+		auto it = std::lower_bound(order.begin(), order.end(), *first, lower);
+		if (it == order.end() || *first < values[*it]) continue;
+		const std::size_t group = it - order.begin();
+		const std::size_t pos   = head[group];
+		if (pos == count || *first < values[order[pos]]) continue; // group done
+		result[order[pos]] = first;
+		head[group]        = pos + 1;
+		--missing;
+	}
+	if (missing != 0) result.clear();
+	return result;
+}
+
+//! @brief More values than inputs (random access inputs only).
+template <class InputIterator, class ValueIterator>
+bool
+tooManyValues(InputIterator first,
+              InputIterator last,
+              ValueIterator valFirst,
+              ValueIterator valLast,
+              std::random_access_iterator_tag) {
+	return std::distance(valFirst, valLast) > last - first;
+}
+
+template <class InputIterator, class ValueIterator>
+bool
+tooManyValues(InputIterator,
+              InputIterator,
+              ValueIterator,
+              ValueIterator,
+              std::input_iterator_tag) {
+	return false;
+}
+
+//! Minimum number of inputs per thread of find_tuple_parallel.
+constexpr std::size_t kMinChunk = 1 << 14;
+
+template <class RandomIt, class ValueIterator, class Tag>
+std::vector<RandomIt>
+findTupleParallel(RandomIt first,
+                  RandomIt last,
+                  ValueIterator valFirst,
+                  ValueIterator valLast,
+                  unsigned,
+                  Tag) {
+	return find_tuple(first, last, valFirst, valLast);
+}
+
+template <class RandomIt, class ValueIterator>
+std::vector<RandomIt>
+findTupleParallel(RandomIt first,
+                  RandomIt last,
+                  ValueIterator valFirst,
+                  ValueIterator valLast,
+                  unsigned threads,
+                  HashTag) {
+	using Value              = typename std::iterator_traits<RandomIt>::value_type;
+	const std::size_t size   = last - first;
+	const std::size_t chunks = std::max<std::size_t>(
+	  1, std::min<std::size_t>(threads, size / kMinChunk));
+	if (chunks == 1) return find_tuple(first, last, valFirst, valLast);
+
+	// ids: value -> id, need[id]: occurrences of the value in the tuple.
+	std::unordered_map<Value, std::size_t> ids;
+	std::vector<std::size_t> need, valueIds;
+	for (; valFirst != valLast; ++valFirst) {
+		auto res = ids.emplace(*valFirst, need.size());
+		if (res.second) need.push_back(0);
+		++need[res.first->second];
+		valueIds.push_back(res.first->second);
+	}
+	const std::size_t count = valueIds.size();
+	const std::size_t kinds = need.size();
+	if (count > size) return std::vector<RandomIt>();
+
+	// Positions of the id k-th occurrence in the chunk c are at
+	// found[c * count + offset[id] + k], with k < taken[c * kinds + id].
+	std::vector<std::size_t> offset(kinds + 1, 0);
+	std::partial_sum(need.begin(), need.end(), offset.begin() + 1);
+	std::vector<std::size_t> found(chunks * count), taken(chunks * kinds, 0);
+	std::atomic<std::size_t> complete(chunks); // first chunk matching everything
+	const auto& index = ids;
+	auto scan         = [&](std::size_t c) {
+		std::size_t missing   = count;
+		const std::size_t end = (c + 1) * size / chunks;
+		for (std::size_t i = c * size / chunks; i < end && missing != 0; ++i) {
+			if ((i & 1023) == 0 && complete.load(std::memory_order_relaxed) < c) return;
+			auto it = index.find(first[i]);
+			if (it == index.end()) continue;
+			const std::size_t id = it->second;
+			std::size_t& n       = taken[c * kinds + id];
+			if (n == need[id]) continue;
+			found[c * count + offset[id] + n++] = i;
+			--missing;
+		}
+		if (missing != 0) return;
+		std::size_t cur = complete.load();
+		while (c < cur && !complete.compare_exchange_weak(cur, c)) {}
+	};
+	std::vector<std::thread> workers;
+	for (std::size_t c = 1; c < chunks; ++c)
+		workers.emplace_back(scan, c);
+	scan(0);
+	for (auto& worker : workers)
+		worker.join();
+
+	// Earliest positions of each id over the chunks in order, then given to
+	// the values in order.
+	std::vector<std::size_t> merged(count), used(kinds, 0);
+	for (std::size_t c = 0; c < chunks; ++c) {
+		for (std::size_t id = 0; id < kinds; ++id) {
+			const std::size_t n = std::min(taken[c * kinds + id], need[id] - used[id]);
+			std::copy_n(found.begin() + c * count + offset[id],
+			            n,
+			            merged.begin() + offset[id] + used[id]);
+			used[id] += n;
+		}
+	}
+	if (used != need) return std::vector<RandomIt>();
+	std::fill(used.begin(), used.end(), 0);
+	std::vector<RandomIt> result;
+	result.reserve(count);
+	for (auto id : valueIds)
+		result.push_back(first + merged[offset[id] + used[id]++]);
+	return result;
+}
+}
+
+template <class InputIterator, class ValueIterator>
+std::vector<InputIterator>
+find_tuple(InputIterator first,
+           InputIterator last,
+           ValueIterator valFirst,
+           ValueIterator valLast) {
+	using Input = typename std::iterator_traits<InputIterator>::value_type;
+	using Value = typename std::iterator_traits<ValueIterator>::value_type;
+	using Engine   = details::Engine<Input, Value>;
+	using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+	if (details::tooManyValues(first, last, valFirst, valLast, Category()))
+		return std::vector<InputIterator>();
+	return details::findTuple(first, last, valFirst, valLast, Engine());
+}
+
+template <class RandomIt, class ValueIterator>
+std::vector<RandomIt>
+find_tuple_parallel(RandomIt first,
+                    RandomIt last,
+                    ValueIterator valFirst,
+                    ValueIterator valLast,
+                    unsigned threads) {
+	using Category = typename std::iterator_traits<RandomIt>::iterator_category;
+	static_assert(std::is_base_of<std::random_access_iterator_tag, Category>::value,
+	              "Inputs must be random access.");
+	using Input  = typename std::iterator_traits<RandomIt>::value_type;
+	using Value  = typename std::iterator_traits<ValueIterator>::value_type;
+	using Engine = details::Engine<Input, Value>;
+	return details::findTupleParallel(first, last, valFirst, valLast, threads, Engine());
+}
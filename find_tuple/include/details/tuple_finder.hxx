@@ -0,0 +1,54 @@
+#pragma once
+
+#include <tuple_finder.hpp>
+
+#include <type_traits>
+
+template <class InputIterator>
+tuple_finder<InputIterator>::tuple_finder(InputIterator first, InputIterator last)
+  : _generation(0) {
+	// Count the occurrences of each value, then place the positions of each
+	// value in its range of _positions (i.e. counting sort by value).
+	std::size_t count = 0;
+	for (auto it = first; it != last; ++it, ++count)
+		++_index.emplace(*it, Slot{0, 0, 0, 0}).first->second.last;
+	std::size_t offset = 0;
+	for (auto& it : _index) {
+		it.second.first = it.second.next = offset;
+		offset += it.second.last;
+		it.second.last = it.second.first;
+	}
+	_positions.resize(count, last);
+	for (auto it = first; it != last; ++it)
+		_positions[_index.find(*it)->second.last++] = it;
+}
+
+template <class InputIterator>
+template <class ValueIterator, class OutputIterator>
+bool
+tuple_finder<InputIterator>::find(ValueIterator valFirst,
+                                  ValueIterator valLast,
+                                  OutputIterator out) {
+	using Value = typename std::iterator_traits<ValueIterator>::value_type;
+	static_assert(std::is_same<Value, value_type>::value,
+	              "Values and inputs must have the same type.");
+	++_generation; // release the positions taken by the previous query
+	for (; valFirst != valLast; ++valFirst) {
+		auto it = _index.find(*valFirst);
+		if (it == _index.end()) return false;
+		Slot& slot = it->second;
+		if (slot.generation != _generation) {
+			slot.generation = _generation;
+			slot.next       = slot.first;
+		}
+		if (slot.next == slot.last) return false;
+		*out++ = _positions[slot.next++];
+	}
+	return true;
+}
+
+template <class InputIterator>
+std::size_t
+tuple_finder<InputIterator>::size() const {
+	return _positions.size();
+}
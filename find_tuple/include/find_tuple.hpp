@@ -0,0 +1,41 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+
+//! @brief Find a position of each value of [valFirst, valLast) in [first, last).
+//! Each value takes the first position equal to it not already taken by a
+//! previous value (i.e. duplicated values take successive occurrences).
+//! @return the positions in the order of the values, or an empty vector if
+//! one of the values can not be matched.
+//! The matching engine depends on the value type (same type for inputs and
+//! values):
+//! - hashable: one pass on the inputs with a hash index of the values, O(N + M),
+//! - less than comparable: one pass with a sorted index, O((N + M) log M),
+//! - otherwise (or different types): linear search of each value, O(N * M),
+//!   returning as soon as a value is not found.
+//! The hash and sort engines stop once every value is matched, a missing value
+//! is only proven at the end of the inputs (see tuple_finder for repeated
+//! negative lookups). All engines return at once if there are more values than
+//! random access inputs.
+template <class InputIterator, class ValueIterator>
+std::vector<InputIterator> find_tuple(InputIterator first,
+                                      InputIterator last,
+                                      ValueIterator valFirst,
+                                      ValueIterator valLast);
+
+//! @brief Same as find_tuple on random access inputs using threads.
+//! The inputs are cut into one chunk per thread, each thread collecting the
+//! first positions of each value in its chunk, then the chunks are merged in
+//! order so the positions are the same as find_tuple ones. A chunk stops once
+//! a previous chunk matched every value.
+//! Hashable values only, other types (and small inputs) run find_tuple.
+template <class RandomIt, class ValueIterator>
+std::vector<RandomIt> find_tuple_parallel(
+  RandomIt first,
+  RandomIt last,
+  ValueIterator valFirst,
+  ValueIterator valLast,
+  unsigned threads = std::thread::hardware_concurrency());
+
+#include "details/find_tuple.hxx"
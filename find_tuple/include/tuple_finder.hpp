@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+//! @class tuple_finder find_tuple on the same inputs for many value tuples.
+//! The inputs are indexed once (value -> positions in input order). A query
+//! does no allocation: it writes the positions in a caller buffer and the
+//! positions taken by the previous query are released by bumping a generation
+//! counter (i.e. no reset of the index).
+//! The value type must be hashable and the inputs must stay valid (and
+//! unmodified) while the finder is used.
+template <class InputIterator>
+class tuple_finder {
+	public:
+	using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+	tuple_finder(InputIterator first, InputIterator last);
+
+	//! @brief Same as find_tuple(first, last, valFirst, valLast) writing the
+	//! positions to out (i.e. std::distance(valFirst, valLast) iterators).
+	//! @return false if one of the values can not be matched, then out content
+	//! is unspecified. Return as soon as a value is missing.
+	template <class ValueIterator, class OutputIterator>
+	bool find(ValueIterator valFirst, ValueIterator valLast, OutputIterator out);
+
+	//! @brief Number of inputs.
+	std::size_t size() const;
+
+	private:
+	struct Slot {
+		std::size_t first;      // positions of the value are in
+		std::size_t last;       // _positions[first, last)
+		std::size_t next;       // next position to take if generation is current
+		std::size_t generation; // query which took the last position
+	};
+
+	std::unordered_map<value_type, Slot> _index;
+	std::vector<InputIterator> _positions; // grouped by value, in input order
+	std::size_t _generation;
+};
+
+#include "details/tuple_finder.hxx"
@@ -1,46 +1,109 @@
 #include <algorithm>
+#include <array>
+#include <iostream>
+#include <list>
 #include <numeric>
+#include <random>
+#include <set>
+#include <stdexcept>
 #include <vector>
 
-template <class InputIterator, class ValueIterator>
-std::vector<InputIterator>
-find_tuple(InputIterator first,
-           InputIterator last,
-           ValueIterator valFirst,
-           ValueIterator valLast) {
-	std::vector<InputIterator> inputs(std::distance(first, last));
-	std::iota(inputs.begin(), inputs.end(), first);
-
-	std::vector<InputIterator> result;
-	result.reserve(std::distance(valFirst, valLast));
-
-	// Find first element equal to v, remove it from inputs and add it to res.
-	// need "const auto&" (c++14) to work with std::array (return T* not an
-	// iterator on begin()/end() )
-	auto func = [&result, &inputs](const auto& v) {
-		for (auto it = inputs.begin(); it != inputs.end(); ++it) {
-			if (**it == v) {
-				result.push_back(*it);
-				inputs.erase(it);
-				break;
-			}
-		}
-	};
-	std::for_each(valFirst, valLast, func);
-	if (result.size() == std::distance(valFirst, valLast))
-		return result;
-	else
-		return std::vector<InputIterator>();
+#include <find_tuple.hpp>
+#include <tuple_finder.hpp>
+
+//! @struct Key Value only less than comparable (i.e. sort engine).
+struct Key {
+	int v;
+	bool operator==(const Key& rhs) const { return v == rhs.v; }
+	bool operator<(const Key& rhs) const { return v < rhs.v; }
+};
+
+//! @struct Tag Value only equality comparable (i.e. linear engine).
+struct Tag {
+	int v;
+	bool operator==(const Tag& rhs) const { return v == rhs.v; }
+};
+
+static_assert(std::is_same<details::Engine<int, int>, details::HashTag>::value, "");
+static_assert(std::is_same<details::Engine<Key, Key>, details::SortTag>::value, "");
+static_assert(std::is_same<details::Engine<Tag, Tag>, details::LinearTag>::value, "");
+static_assert(std::is_same<details::Engine<int, long>, details::LinearTag>::value, "");
+
+//! @brief Check the engine of T against the linear one on random tuples
+//! (duplicated and missing values included).
+template <typename T>
+void
+checkEngine() {
+	std::mt19937 gen(42);
+	for (int i = 0; i < 200; ++i) {
+		std::uniform_int_distribution<int> value(0, 1 + i % 20);
+		std::list<T> inputs;
+		std::vector<T> vals;
+		for (int j = i % 50; j > 0; --j)
+			inputs.push_back(T{value(gen)});
+		for (int j = i % 7; j > 0; --j)
+			vals.push_back(T{value(gen)});
+
+		auto res = find_tuple(inputs.begin(), inputs.end(), vals.begin(), vals.end());
+		auto ref = details::findTuple(
+		  inputs.begin(), inputs.end(), vals.begin(), vals.end(), details::LinearTag());
+		if (res != ref) throw std::runtime_error("find_tuple engine mismatch");
+	}
 }
 
-#include <algorithm>
-#include <array>
-#include <iostream>
-#include <list>
-#include <set>
+//! @brief Check repeated tuple_finder queries against find_tuple.
+void
+checkFinder() {
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> value(0, 20);
+	std::list<int> inputs;
+	for (int i = 0; i < 100; ++i)
+		inputs.push_back(value(gen));
+
+	tuple_finder<std::list<int>::iterator> finder(inputs.begin(), inputs.end());
+	std::vector<std::list<int>::iterator> out(10);
+	for (int i = 0; i < 500; ++i) {
+		std::vector<int> vals(i % 10);
+		for (auto& v : vals)
+			v = value(gen) + (i % 5 == 0); // 21 is missing
+		auto ref = find_tuple(inputs.begin(), inputs.end(), vals.begin(), vals.end());
+		const bool found = finder.find(vals.begin(), vals.end(), out.begin());
+		if (found != (ref.size() == vals.size()) ||
+		    (found && !std::equal(ref.begin(), ref.end(), out.begin())))
+			throw std::runtime_error("tuple_finder mismatch");
+	}
+}
+
+//! @brief Check find_tuple_parallel against find_tuple (several chunks).
+void
+checkParallel() {
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> value(0, 5000);
+	std::vector<int> inputs(100000);
+	for (auto& v : inputs)
+		v = value(gen);
+	for (int i = 0; i < 50; ++i) {
+		std::vector<int> vals(i % 20);
+		for (auto& v : vals)
+			v = value(gen) + (i % 5 == 0 ? 5000 : 0); // may be missing
+		auto ref = find_tuple(inputs.begin(), inputs.end(), vals.begin(), vals.end());
+		auto res =
+		  find_tuple_parallel(inputs.begin(), inputs.end(), vals.begin(), vals.end(), 4);
+		if (res != ref) throw std::runtime_error("find_tuple_parallel mismatch");
+	}
+	std::vector<Key> keys(20000, Key{1}), vals(3, Key{1});
+	if (find_tuple_parallel(keys.begin(), keys.end(), vals.begin(), vals.end(), 4) !=
+	    find_tuple(keys.begin(), keys.end(), vals.begin(), vals.end()))
+		throw std::runtime_error("find_tuple_parallel fallback mismatch");
+}
 
 int
 main() {
+	checkEngine<int>();
+	checkEngine<Key>();
+	checkFinder();
+	checkParallel();
+
 	std::list<int> l(10);
 	std::iota(l.begin(), l.end(), 0);
 
@@ -0,0 +1,135 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "intrusive_ptr.hpp"
+#include "measure.hpp"
+
+// Copy, cast and destroy throughput of std::shared_ptr against intrusive_ptr
+// (atomic and plain counts) on the IFoo/FooBase/FooDerived hierarchy.
+// usage: IntrusiveBench [objects] [rounds]
+
+namespace shared {
+struct IFoo {
+	virtual ~IFoo() = default;
+	virtual std::shared_ptr<IFoo> getPtr() = 0;
+	int value = 0;
+};
+
+struct FooBase : std::enable_shared_from_this<FooBase>, IFoo {
+	std::shared_ptr<IFoo> getPtr() override { return shared_from_this(); }
+};
+
+struct FooDerived : FooBase {
+	std::shared_ptr<IFoo> getPtr() override { return shared_from_this(); }
+};
+
+struct Traits {
+	template <typename T>
+	using ptr = std::shared_ptr<T>;
+	template <typename T>
+	static ptr<T> make() {
+		return std::make_shared<T>();
+	}
+	template <typename T, typename U>
+	static ptr<T> staticCast(const ptr<U>& p) {
+		return std::static_pointer_cast<T>(p);
+	}
+	template <typename T, typename U>
+	static ptr<T> dynamicCast(const ptr<U>& p) {
+		return std::dynamic_pointer_cast<T>(p);
+	}
+};
+} // namespace shared
+
+namespace intrusive {
+template <typename Count>
+struct IFoo : RefCounted<Count> {
+	virtual intrusive_ptr<IFoo> getPtr() = 0;
+	int value = 0;
+};
+
+template <typename Count>
+struct FooBase : IFoo<Count> {
+	intrusive_ptr<IFoo<Count>> getPtr() override { return this->from_this(this); }
+};
+
+template <typename Count>
+struct FooDerived : FooBase<Count> {
+	intrusive_ptr<IFoo<Count>> getPtr() override { return this->from_this(this); }
+};
+
+template <typename Count>
+struct Traits {
+	template <typename T>
+	using ptr = intrusive_ptr<T>;
+	template <typename T>
+	static ptr<T> make() {
+		return make_intrusive<T>();
+	}
+	template <typename T, typename U>
+	static ptr<T> staticCast(const ptr<U>& p) {
+		return static_pointer_cast<T>(p);
+	}
+	template <typename T, typename U>
+	static ptr<T> dynamicCast(const ptr<U>& p) {
+		return dynamic_pointer_cast<T>(p);
+	}
+};
+} // namespace intrusive
+
+using bench::measure;
+
+template <typename Traits, typename IFoo, typename FooDerived>
+void
+run(const char* name, std::size_t count, int rounds) {
+	using Ptr = typename Traits::template ptr<IFoo>;
+	double make = 0, copy = 0, cast = 0, dyn = 0, destroy = 0;
+	long sum = 0;
+	for (int r = 0; r < rounds; ++r) {
+		std::vector<Ptr> objects;
+		objects.reserve(count);
+		make += measure([&] {
+			for (std::size_t i = 0; i < count; ++i)
+				objects.push_back(Traits::template make<FooDerived>());
+		});
+		std::vector<Ptr> copies;
+		copies.reserve(count);
+		copy += measure([&] {
+			for (const auto& p : objects)
+				copies.push_back(p);
+			copies.clear();
+		});
+		cast += measure([&] {
+			for (const auto& p : objects)
+				sum += Traits::template staticCast<FooDerived>(p->getPtr())->value;
+		});
+		dyn += measure([&] {
+			for (const auto& p : objects)
+				sum += Traits::template dynamicCast<FooDerived>(p->getPtr())->value;
+		});
+		destroy += measure([&] { objects.clear(); });
+	}
+	const double ops = static_cast<double>(count) * rounds;
+	std::cout << name << ": make " << make / ops << " ns, copy " << copy / ops
+	          << " ns, getPtr+static_cast " << cast / ops << " ns, getPtr+dynamic_cast "
+	          << dyn / ops << " ns, destroy " << destroy / ops << " ns" << std::endl;
+	if (sum != 0) std::cout << "unexpected value" << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const std::size_t count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	const int rounds        = argc > 2 ? std::atoi(argv[2]) : 5;
+
+	run<shared::Traits, shared::IFoo, shared::FooDerived>(
+	  "std::shared_ptr             ", count, rounds);
+	run<intrusive::Traits<AtomicCount>,
+	    intrusive::IFoo<AtomicCount>,
+	    intrusive::FooDerived<AtomicCount>>(
+	  "intrusive_ptr<AtomicCount>  ", count, rounds);
+	run<intrusive::Traits<PlainCount>,
+	    intrusive::IFoo<PlainCount>,
+	    intrusive::FooDerived<PlainCount>>("intrusive_ptr<PlainCount>   ", count, rounds);
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+//! @struct AtomicCount Thread safe reference count (objects shared between
+//! threads).
+struct AtomicCount {
+	void increment() { _value.fetch_add(1, std::memory_order_relaxed); }
+	//! @brief Return true if it was the last reference.
+	bool decrement() { return _value.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+	long load() const { return _value.load(std::memory_order_relaxed); }
+
+	private:
+	std::atomic<long> _value{0};
+};
+
+//! @struct PlainCount Reference count of objects used by a single thread (no
+//! atomic instruction).
+struct PlainCount {
+	void increment() { ++_value; }
+	bool decrement() { return --_value == 0; }
+	long load() const { return _value; }
+
+	private:
+	long _value = 0;
+};
+
+template <typename T>
+class intrusive_ptr;
+
+//! @class RefCounted Base of the objects owned by intrusive_ptr: the count is
+//! stored in the object (no control block), Count is AtomicCount or PlainCount.
+//! The object is deleted (virtual destructor) when the last intrusive_ptr is
+//! released, make_intrusive is the only way to get its first owner.
+template <typename Count = AtomicCount>
+class RefCounted {
+	public:
+	//! @brief Number of intrusive_ptr owning the object.
+	long use_count() const { return _count.load(); }
+
+	protected:
+	RefCounted() = default;
+	// A copy is a new object: it does not copy the count.
+	RefCounted(const RefCounted&) {}
+	RefCounted& operator=(const RefCounted&) { return *this; }
+	virtual ~RefCounted() = default;
+
+	//! @brief intrusive_ptr on this with the static type of the caller, e.g.
+	//! from_this(this) in a FooDerived method is an intrusive_ptr<FooDerived>.
+	//! Valid in any derived class, but as shared_from_this an intrusive_ptr must
+	//! already own the object: throw std::bad_weak_ptr otherwise (e.g. on a stack
+	//! object or in a constructor).
+	template <typename Self>
+	static intrusive_ptr<Self> from_this(Self* self) {
+		if (self->use_count() == 0) throw std::bad_weak_ptr();
+		return intrusive_ptr<Self>(self);
+	}
+
+	private:
+	template <typename T>
+	friend class intrusive_ptr;
+
+	void addRef() const { _count.increment(); }
+	void release() const {
+		if (_count.decrement()) delete this;
+	}
+
+	mutable Count _count;
+};
+
+//! @class intrusive_ptr Shared ownership of a RefCounted object, the size of a
+//! raw pointer. Copies only increment the count stored in the object.
+template <typename T>
+class intrusive_ptr {
+	public:
+	using element_type = T;
+
+	intrusive_ptr() = default;
+	intrusive_ptr(std::nullptr_t) {}
+	intrusive_ptr(const intrusive_ptr& rhs)
+	  : intrusive_ptr(rhs._ptr) {}
+	intrusive_ptr(intrusive_ptr&& rhs) noexcept
+	  : _ptr(rhs._ptr) {
+		rhs._ptr = nullptr;
+	}
+	template <typename U>
+	intrusive_ptr(const intrusive_ptr<U>& rhs)
+	  : intrusive_ptr(rhs.get()) {}
+	template <typename U>
+	intrusive_ptr(intrusive_ptr<U>&& rhs) noexcept
+	  : _ptr(rhs.detach()) {}
+	~intrusive_ptr() {
+		if (_ptr) _ptr->release();
+	}
+
+	intrusive_ptr& operator=(intrusive_ptr rhs) noexcept {
+		swap(rhs);
+		return *this;
+	}
+
+	T* get() const { return _ptr; }
+	T& operator*() const { return *_ptr; }
+	T* operator->() const { return _ptr; }
+	explicit operator bool() const { return _ptr != nullptr; }
+	long use_count() const { return _ptr ? _ptr->use_count() : 0; }
+
+	void reset() { intrusive_ptr().swap(*this); }
+	void swap(intrusive_ptr& rhs) noexcept { std::swap(_ptr, rhs._ptr); }
+	//! @brief Give up the ownership without releasing the reference.
+	T* detach() {
+		T* res = _ptr;
+		_ptr   = nullptr;
+		return res;
+	}
+
+	private:
+	template <typename U>
+	friend class intrusive_ptr;
+	template <typename Count>
+	friend class RefCounted;
+	template <typename U, typename... Args>
+	friend intrusive_ptr<U> make_intrusive(Args&&... args);
+	template <typename U, typename V>
+	friend intrusive_ptr<U> static_pointer_cast(const intrusive_ptr<V>& p);
+	template <typename U, typename V>
+	friend intrusive_ptr<U> dynamic_pointer_cast(const intrusive_ptr<V>& p);
+
+	//! Take a reference on p (so p may already be owned by other intrusive_ptr).
+	//! Private: a raw pointer is only adopted by make_intrusive.
+	explicit intrusive_ptr(T* p)
+	  : _ptr(p) {
+		if (_ptr) _ptr->addRef();
+	}
+
+	T* _ptr = nullptr;
+};
+
+//! @brief Allocate a T and return its first owner.
+template <typename T, typename... Args>
+intrusive_ptr<T>
+make_intrusive(Args&&... args) {
+	return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+//! @{
+//! @brief Same as std::static_pointer_cast and std::dynamic_pointer_cast.
+template <typename T, typename U>
+intrusive_ptr<T>
+static_pointer_cast(const intrusive_ptr<U>& p) {
+	return intrusive_ptr<T>(static_cast<T*>(p.get()));
+}
+
+template <typename T, typename U>
+intrusive_ptr<T>
+dynamic_pointer_cast(const intrusive_ptr<U>& p) {
+	return intrusive_ptr<T>(dynamic_cast<T*>(p.get()));
+}
+//! @}
+
+template <typename T, typename U>
+bool
+operator==(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) {
+	return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U>
+bool
+operator!=(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) {
+	return lhs.get() != rhs.get();
+}
@@ -1,5 +1,8 @@
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+
+#include "intrusive_ptr.hpp"
 
 struct Good : std::enable_shared_from_this<Good> {
 	std::shared_ptr<Good> getptr() { return shared_from_this(); }
@@ -32,6 +35,44 @@ struct FooDerived : public FooBase {
 	}
 };
 
+// Same hierarchy with the count in the object: from_this() is valid from any
+// class of the hierarchy and already returns the type of the caller.
+namespace intrusive {
+struct IFoo : RefCounted<> {
+	virtual ~IFoo() { std::cout << "intrusive::IFoo::~IFoo() called\n"; }
+	virtual intrusive_ptr<IFoo> getPtr() = 0;
+};
+
+struct FooBase : IFoo {
+	virtual ~FooBase() { std::cout << "intrusive::FooBase::~FooBase() called\n"; }
+	virtual intrusive_ptr<IFoo> getPtr() {
+		std::cout << "intrusive::FooBase::getPtr() called\n";
+		return from_this(this);
+	}
+};
+
+struct FooDerived : public FooBase {
+	virtual ~FooDerived() {
+		std::cout << "intrusive::FooDerived::~FooDerived() called\n";
+	}
+	virtual intrusive_ptr<IFoo> getPtr() {
+		std::cout << "intrusive::FooDerived::getPtr() called\n";
+		return from_this(this);
+	}
+	intrusive_ptr<FooDerived> getDerived() { return from_this(this); }
+};
+
+// Single threaded objects: plain (non atomic) count.
+struct Local : RefCounted<PlainCount> {
+	intrusive_ptr<Local> getPtr() { return from_this(this); }
+};
+} // namespace intrusive
+
+void
+check(bool condition, const char* what) {
+	if (!condition) throw std::runtime_error(what);
+}
+
 int
 main() {
 	{ // Good: the two shared_ptr's share the same object
@@ -72,4 +113,44 @@ main() {
 		std::cout << "foo3Ptr.use_count() = " << foo3Ptr.use_count() << '\n'; // 3
 		std::cout << "foo4Ptr.use_count() = " << foo4Ptr.use_count() << '\n'; // 0
 	}
+
+	{
+		intrusive_ptr<intrusive::IFoo> fooPtr = make_intrusive<intrusive::FooDerived>();
+		intrusive_ptr<intrusive::IFoo> foo2Ptr = fooPtr->getPtr();
+		intrusive_ptr<intrusive::FooDerived> foo3Ptr =
+		  static_pointer_cast<intrusive::FooDerived>(fooPtr->getPtr());
+		intrusive_ptr<intrusive::FooDerived> foo4Ptr =
+		  dynamic_pointer_cast<intrusive::FooDerived>(fooPtr->getPtr());
+		intrusive_ptr<intrusive::FooDerived> foo5Ptr = foo4Ptr->getDerived();
+		std::cout << "foo2Ptr.use_count() = " << foo2Ptr.use_count() << '\n'; // 5
+		check(foo5Ptr.use_count() == 5 && foo5Ptr == fooPtr, "intrusive from_this");
+		check(sizeof(foo2Ptr) == sizeof(void*), "intrusive_ptr size");
+	}
+	{
+		intrusive_ptr<intrusive::IFoo> fooPtr = make_intrusive<intrusive::FooBase>();
+		intrusive_ptr<intrusive::IFoo> foo2Ptr = fooPtr->getPtr();
+		intrusive_ptr<intrusive::FooDerived> foo4Ptr =
+		  dynamic_pointer_cast<intrusive::FooDerived>(fooPtr->getPtr()); // empty
+		std::cout << "foo2Ptr.use_count() = " << foo2Ptr.use_count() << '\n'; // 2
+		check(foo2Ptr.use_count() == 2 && !foo4Ptr && foo4Ptr.use_count() == 0,
+		      "intrusive dynamic_pointer_cast");
+		foo2Ptr.reset();
+		check(fooPtr.use_count() == 1, "intrusive reset");
+	}
+	{
+		intrusive_ptr<intrusive::Local> local = make_intrusive<intrusive::Local>();
+		intrusive_ptr<intrusive::Local> copy  = local->getPtr();
+		intrusive_ptr<intrusive::Local> moved = std::move(copy);
+		check(local.use_count() == 2 && !copy, "intrusive plain count");
+	}
+	{ // No owner: from_this() throws as shared_from_this (no silent delete).
+		intrusive::Local local;
+		bool thrown = false;
+		try {
+			local.getPtr();
+		} catch (const std::bad_weak_ptr&) {
+			thrown = true;
+		}
+		check(thrown && local.use_count() == 0, "intrusive from_this without owner");
+	}
 }
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "jagged.hpp"
+
+//! @brief Number of values of the rows [first, last).
+template <class RowIt>
+std::size_t flatten_size(RowIt first, RowIt last);
+
+//! @brief Copy the values of the rows [first, last) (a random access range of
+//! ranges, e.g. std::vector<std::vector<T>>) to out, row after row.
+//! out is random access with room for flatten_size(first, last) values.
+//! Two passes: the row sizes are summed (parallel prefix sum) then each thread
+//! copies an equal share of the values (so a big row is split), with memcpy
+//! for trivially copyable values on contiguous ranges.
+//! @return out + flatten_size(first, last).
+template <class RowIt, class OutIt>
+OutIt flatten(RowIt first,
+              RowIt last,
+              OutIt out,
+              unsigned threads = std::thread::hardware_concurrency());
+
+//! @brief Rows r of [first, last) such as pred(r), compacted in a jagged array.
+//! pred is called once per row (in parallel), then the output is allocated at
+//! its exact size and filled as flatten(): the values must be default
+//! constructible (the buffer is value initialized, then assigned in parallel).
+template <class RowIt, class Pred>
+auto copy_if_compact(RowIt first,
+                     RowIt last,
+                     Pred pred,
+                     unsigned threads = std::thread::hardware_concurrency());
+
+namespace details {
+//! Minimum number of rows or values per thread.
+constexpr std::size_t kMinChunk = 1 << 14;
+
+//! @brief Number of slices of count items for threads threads.
+inline std::size_t
+chunkCount(std::size_t count, unsigned threads) {
+	return std::max<std::size_t>(1, std::min<std::size_t>(threads, count / kMinChunk));
+}
+
+//! @brief Call func(c, begin, end) on each of the chunks slices [begin, end) of
+//! [0, count), one thread per slice (the first one on the calling thread).
+//! Every thread is joined, then the exception of the first slice which threw
+//! (if any) is rethrown.
+template <typename F>
+void
+parallelFor(std::size_t count, std::size_t chunks, F&& func) {
+	std::vector<std::exception_ptr> errors(chunks);
+	auto slice = [&func, &errors, count, chunks](std::size_t c) {
+		try {
+			func(c, c * count / chunks, (c + 1) * count / chunks);
+		} catch (...) {
+			errors[c] = std::current_exception();
+		}
+	};
+	std::vector<std::thread> workers;
+	workers.reserve(chunks);
+	for (std::size_t c = 1; c < chunks; ++c) {
+		try {
+			workers.emplace_back(slice, c);
+		} catch (...) { // no more thread: run the slice here
+			slice(c);
+		}
+	}
+	slice(0);
+	for (auto& worker : workers)
+		worker.join();
+	for (const auto& error : errors) {
+		if (error) std::rethrow_exception(error);
+	}
+}
+
+//! @brief offsets[i] = sum of sizes[0, i) (offsets has one more element).
+inline void
+prefixSum(const std::vector<std::size_t>& sizes,
+          std::vector<std::size_t>& offsets,
+          unsigned threads) {
+	// Sum of each slice, then each slice is scanned from the sum of the
+	// previous ones.
+	const std::size_t count  = sizes.size();
+	const std::size_t chunks = chunkCount(count, threads);
+	std::vector<std::size_t> sums(chunks + 1, 0);
+	parallelFor(count, chunks, [&](std::size_t c, std::size_t b, std::size_t e) {
+		sums[c + 1] = std::accumulate(sizes.begin() + b, sizes.begin() + e, std::size_t(0));
+	});
+	std::partial_sum(sums.begin(), sums.end(), sums.begin());
+	offsets.resize(count + 1);
+	parallelFor(count, chunks, [&](std::size_t c, std::size_t b, std::size_t e) {
+		std::size_t sum = sums[c];
+		for (std::size_t i = b; i < e; ++i) {
+			offsets[i] = sum;
+			sum += sizes[i];
+		}
+	});
+	offsets[count] = sums[chunks];
+}
+
+//! @brief Copy the values [begin, end) of the rows first[rows[i]] flattened
+//! (rows may be empty for all the rows) to out + begin.
+template <class RowIt, class OutIt>
+void
+copyValues(RowIt first,
+           const std::vector<std::size_t>& rows,
+           const std::vector<std::size_t>& offsets,
+           OutIt out,
+           std::size_t begin,
+           std::size_t end) {
+	// Last row starting at or before begin (i.e. holding it, empty rows skipped).
+	auto row = std::upper_bound(offsets.begin(), offsets.end(), begin) - 1;
+	for (std::size_t i = row - offsets.begin(), pos = begin; pos < end; ++i) {
+		const auto& values  = first[rows.empty() ? i : rows[i]];
+		const std::size_t k = pos - offsets[i];
+		const std::size_t n = std::min(offsets[i + 1], end) - pos;
+		using In            = decltype(std::begin(values));
+		using Value         = std::iter_value_t<In>;
+		if constexpr (std::is_trivially_copyable_v<Value> &&
+		              std::contiguous_iterator<In> && std::contiguous_iterator<OutIt>) {
+			if (n != 0) {
+				std::memcpy(std::to_address(out + pos),
+				            std::to_address(std::begin(values) + k),
+				            n * sizeof(Value));
+			}
+		} else {
+			std::copy_n(std::next(std::begin(values), k), n, out + pos);
+		}
+		pos += n;
+	}
+}
+}
+
+template <class RowIt>
+std::size_t
+flatten_size(RowIt first, RowIt last) {
+	std::size_t res = 0;
+	for (; first != last; ++first)
+		res += std::size(*first);
+	return res;
+}
+
+template <class RowIt, class OutIt>
+OutIt
+flatten(RowIt first, RowIt last, OutIt out, unsigned threads) {
+	const std::size_t count = last - first;
+	std::vector<std::size_t> sizes(count), offsets;
+	const std::size_t chunks = details::chunkCount(count, threads);
+	details::parallelFor(count, chunks, [&](std::size_t, std::size_t b, std::size_t e) {
+		for (std::size_t i = b; i < e; ++i)
+			sizes[i] = std::size(first[i]);
+	});
+	details::prefixSum(sizes, offsets, threads);
+
+	const std::size_t total = offsets.back();
+	const std::vector<std::size_t> all; // i.e. every row
+	const std::size_t slices = details::chunkCount(total, threads);
+	details::parallelFor(total, slices, [&](std::size_t, std::size_t b, std::size_t e) {
+		details::copyValues(first, all, offsets, out, b, e);
+	});
+	return out + total;
+}
+
+template <class RowIt, class Pred>
+auto
+copy_if_compact(RowIt first, RowIt last, Pred pred, unsigned threads) {
+	using Value = std::iter_value_t<decltype(std::begin(*first))>;
+	static_assert(std::is_default_constructible_v<Value>,
+	              "copy_if_compact values must be default constructible");
+	// Pass 1: predicate and size of each row, then the selected rows.
+	const std::size_t count = last - first;
+	std::vector<std::size_t> sizes(count), rows, offsets;
+	std::vector<char> keep(count);
+	const std::size_t chunks = details::chunkCount(count, threads);
+	details::parallelFor(count, chunks, [&](std::size_t, std::size_t b, std::size_t e) {
+		for (std::size_t i = b; i < e; ++i)
+			keep[i] = pred(first[i]) ? 1 : 0;
+	});
+	for (std::size_t i = 0; i < count; ++i) {
+		if (keep[i]) rows.push_back(i);
+	}
+	sizes.resize(rows.size());
+	for (std::size_t i = 0; i < rows.size(); ++i)
+		sizes[i] = std::size(first[rows[i]]);
+	details::prefixSum(sizes, offsets, threads);
+
+	// Pass 2: allocate once, copy in parallel.
+	const std::size_t total = offsets.back();
+	std::vector<Value> values(total);
+	const std::size_t slices = details::chunkCount(total, threads);
+	details::parallelFor(total, slices, [&](std::size_t, std::size_t b, std::size_t e) {
+		details::copyValues(first, rows, offsets, values.begin(), b, e);
+	});
+	return jagged<Value>(std::move(offsets), std::move(values));
+}
@@ -0,0 +1,76 @@
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "flatten.hpp"
+#include "measure.hpp"
+
+// Flatten and filter + flatten of a std::vector<std::vector<int>> of 10^3 to
+// 10^7 values (rows of 0 to 128 values): insert loop and back_inserter copy
+// against the two pass flatten / copy_if_compact (1 thread and all threads).
+// usage: FlattenBench [threads]
+
+using bench::measure;
+
+int
+main(int argc, char* argv[]) {
+	const unsigned threads =
+	  argc > 1 ? std::atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<std::size_t> length(0, 128);
+
+	std::cout << "threads: " << threads << std::endl;
+	std::cout << "values, insert, back_inserter, flatten (1), flatten (" << threads
+	          << "), copy_if + insert, copy_if_compact (" << threads << ") (ns/value)"
+	          << std::endl;
+	for (std::size_t total = 1000; total <= 10000000; total *= 10) {
+		std::vector<std::vector<int>> rows;
+		for (std::size_t count = 0; count < total;) {
+			rows.emplace_back(std::min(length(gen), total - count), 1);
+			count += rows.back().size();
+		}
+		auto pred = [](const std::vector<int>& row) { return row.size() % 2 == 0; };
+		long sink = 0;
+
+		const double insert = measure([&]() {
+			std::vector<int> res;
+			for (const auto& row : rows)
+				res.insert(res.end(), row.begin(), row.end());
+			sink += res.size();
+		});
+		const double inserter = measure([&]() {
+			std::vector<int> res;
+			for (const auto& row : rows)
+				std::copy(row.begin(), row.end(), std::back_inserter(res));
+			sink += res.size();
+		});
+		const double serial = measure([&]() {
+			std::vector<int> res(flatten_size(rows.begin(), rows.end()));
+			flatten(rows.begin(), rows.end(), res.begin(), 1);
+			sink += res.size();
+		});
+		const double parallel = measure([&]() {
+			std::vector<int> res(flatten_size(rows.begin(), rows.end()));
+			flatten(rows.begin(), rows.end(), res.begin(), threads);
+			sink += res.size();
+		});
+		const double copyIf = measure([&]() {
+			std::vector<std::vector<int>> filtered;
+			std::copy_if(rows.begin(), rows.end(), std::back_inserter(filtered), pred);
+			std::vector<int> res;
+			for (const auto& row : filtered)
+				res.insert(res.end(), row.begin(), row.end());
+			sink += res.size();
+		});
+		const double compact = measure([&]() {
+			sink += copy_if_compact(rows.begin(), rows.end(), pred, threads).flatten().size();
+		});
+		const double n = static_cast<double>(total);
+		std::cout << total << ", " << insert / n << ", " << inserter / n << ", "
+		          << serial / n << ", " << parallel / n << ", " << copyIf / n << ", "
+		          << compact / n << " (" << sink << ")" << std::endl;
+	}
+}
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+//! @class jagged Array of rows of different sizes in compressed sparse row
+//! layout: the values of all the rows are stored contiguously (row after row)
+//! and offsets[i] is the index of the first value of the row i (offsets has
+//! one more element, the number of values).
+//! So a jagged array is two allocations whatever the number of rows, and its
+//! flattening is free.
+template <typename T>
+class jagged {
+	public:
+	using value_type = T;
+	using row        = std::span<T>;
+	using const_row  = std::span<const T>;
+
+	//! @class iterator Random access iterator on the rows (as spans).
+	template <typename J, typename R>
+	class basic_iterator {
+		public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = R;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = void;
+		using reference         = R;
+
+		basic_iterator() = default;
+		basic_iterator(J* array, std::size_t pos)
+		  : _array(array)
+		  , _pos(pos) {}
+
+		R operator*() const { return (*_array)[_pos]; }
+		R operator[](difference_type n) const { return (*_array)[_pos + n]; }
+		basic_iterator& operator++() { return ++_pos, *this; }
+		basic_iterator& operator--() { return --_pos, *this; }
+		basic_iterator operator++(int) { return basic_iterator(_array, _pos++); }
+		basic_iterator operator--(int) { return basic_iterator(_array, _pos--); }
+		basic_iterator& operator+=(difference_type n) { return _pos += n, *this; }
+		basic_iterator& operator-=(difference_type n) { return _pos -= n, *this; }
+		basic_iterator operator+(difference_type n) const {
+			return basic_iterator(_array, _pos + n);
+		}
+		friend basic_iterator operator+(difference_type n, const basic_iterator& it) {
+			return it + n;
+		}
+		basic_iterator operator-(difference_type n) const {
+			return basic_iterator(_array, _pos - n);
+		}
+		difference_type operator-(const basic_iterator& rhs) const {
+			return static_cast<difference_type>(_pos - rhs._pos);
+		}
+		bool operator==(const basic_iterator& rhs) const { return _pos == rhs._pos; }
+		bool operator!=(const basic_iterator& rhs) const { return _pos != rhs._pos; }
+		bool operator<(const basic_iterator& rhs) const { return _pos < rhs._pos; }
+		bool operator>(const basic_iterator& rhs) const { return _pos > rhs._pos; }
+		bool operator<=(const basic_iterator& rhs) const { return _pos <= rhs._pos; }
+		bool operator>=(const basic_iterator& rhs) const { return _pos >= rhs._pos; }
+
+		private:
+		J* _array        = nullptr;
+		std::size_t _pos = 0;
+	};
+	using iterator       = basic_iterator<jagged, row>;
+	using const_iterator = basic_iterator<const jagged, const_row>;
+
+	//! @class filtered View on the rows of a jagged array matching a predicate
+	//! (i.e. their indices, no value is copied).
+	class filtered {
+		public:
+		filtered(const jagged& array, std::vector<std::size_t> rows);
+
+		std::size_t size() const;
+		bool empty() const;
+		//! @brief i-th matching row.
+		const_row operator[](std::size_t i) const;
+		//! @brief Index in the jagged array of the i-th matching row.
+		std::size_t index(std::size_t i) const;
+
+		basic_iterator<const filtered, const_row> begin() const;
+		basic_iterator<const filtered, const_row> end() const;
+
+		private:
+		const jagged& _array;
+		std::vector<std::size_t> _rows;
+	};
+
+	jagged();
+	//! Copy the rows of a range of ranges (e.g. std::vector<std::vector<T>>),
+	//! the sizes are summed first so each buffer is allocated once.
+	template <typename Rows>
+	explicit jagged(const Rows& rows);
+	jagged(std::initializer_list<std::initializer_list<T>> rows);
+	//! Take the buffers of a jagged array built elsewhere (e.g. copy_if_compact).
+	jagged(std::vector<std::size_t> offsets, std::vector<T> values);
+
+	//! @brief Number of rows.
+	std::size_t size() const;
+	bool empty() const;
+
+	//! @brief Values of the row i.
+	row operator[](std::size_t i);
+	const_row operator[](std::size_t i) const;
+
+	//! @brief Values of all the rows, row after row (no copy).
+	row flatten();
+	const_row flatten() const;
+
+	//! @brief Offsets of the rows in flatten() (size() + 1 elements).
+	std::span<const std::size_t> offsets() const;
+
+	//! @brief Append a row (amortized like std::vector::insert).
+	template <typename Row>
+	void push_back(const Row& values);
+
+	//! @brief View on the rows r such as pred(r) (r is a const_row).
+	template <typename Pred>
+	filtered filter(Pred pred) const;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+	private:
+	std::vector<std::size_t> _offsets;
+	std::vector<T> _values;
+};
+
+//////////////
+//  jagged  //
+//////////////
+
+template <typename T>
+jagged<T>::jagged()
+  : _offsets(1, 0) {}
+
+template <typename T>
+template <typename Rows>
+jagged<T>::jagged(const Rows& rows)
+  : _offsets(1, 0) {
+	_offsets.reserve(std::size(rows) + 1);
+	for (const auto& r : rows)
+		_offsets.push_back(_offsets.back() + std::size(r));
+	_values.reserve(_offsets.back());
+	for (const auto& r : rows)
+		_values.insert(_values.end(), std::begin(r), std::end(r));
+}
+
+template <typename T>
+jagged<T>::jagged(std::initializer_list<std::initializer_list<T>> rows)
+  : jagged(std::vector<std::initializer_list<T>>(rows)) {}
+
+template <typename T>
+jagged<T>::jagged(std::vector<std::size_t> offsets, std::vector<T> values)
+  : _offsets(std::move(offsets))
+  , _values(std::move(values)) {}
+
+template <typename T>
+std::size_t
+jagged<T>::size() const {
+	return _offsets.size() - 1;
+}
+
+template <typename T>
+bool
+jagged<T>::empty() const {
+	return size() == 0;
+}
+
+template <typename T>
+typename jagged<T>::row
+jagged<T>::operator[](std::size_t i) {
+	return row(_values.data() + _offsets[i], _offsets[i + 1] - _offsets[i]);
+}
+
+template <typename T>
+typename jagged<T>::const_row
+jagged<T>::operator[](std::size_t i) const {
+	return const_row(_values.data() + _offsets[i], _offsets[i + 1] - _offsets[i]);
+}
+
+template <typename T>
+typename jagged<T>::row
+jagged<T>::flatten() {
+	return row(_values);
+}
+
+template <typename T>
+typename jagged<T>::const_row
+jagged<T>::flatten() const {
+	return const_row(_values);
+}
+
+template <typename T>
+std::span<const std::size_t>
+jagged<T>::offsets() const {
+	return std::span<const std::size_t>(_offsets);
+}
+
+template <typename T>
+template <typename Row>
+void
+jagged<T>::push_back(const Row& values) {
+	_values.insert(_values.end(), std::begin(values), std::end(values));
+	_offsets.push_back(_values.size());
+}
+
+template <typename T>
+template <typename Pred>
+typename jagged<T>::filtered
+jagged<T>::filter(Pred pred) const {
+	std::vector<std::size_t> rows;
+	for (std::size_t i = 0; i < size(); ++i) {
+		if (pred((*this)[i])) rows.push_back(i);
+	}
+	return filtered(*this, std::move(rows));
+}
+
+template <typename T>
+typename jagged<T>::iterator
+jagged<T>::begin() {
+	return iterator(this, 0);
+}
+
+template <typename T>
+typename jagged<T>::iterator
+jagged<T>::end() {
+	return iterator(this, size());
+}
+
+template <typename T>
+typename jagged<T>::const_iterator
+jagged<T>::begin() const {
+	return const_iterator(this, 0);
+}
+
+template <typename T>
+typename jagged<T>::const_iterator
+jagged<T>::end() const {
+	return const_iterator(this, size());
+}
+
+////////////////
+//  filtered  //
+////////////////
+
+template <typename T>
+jagged<T>::filtered::filtered(const jagged& array, std::vector<std::size_t> rows)
+  : _array(array)
+  , _rows(std::move(rows)) {}
+
+template <typename T>
+std::size_t
+jagged<T>::filtered::size() const {
+	return _rows.size();
+}
+
+template <typename T>
+bool
+jagged<T>::filtered::empty() const {
+	return _rows.empty();
+}
+
+template <typename T>
+typename jagged<T>::const_row
+jagged<T>::filtered::operator[](std::size_t i) const {
+	return _array[_rows[i]];
+}
+
+template <typename T>
+std::size_t
+jagged<T>::filtered::index(std::size_t i) const {
+	return _rows[i];
+}
+
+template <typename T>
+typename jagged<T>::template basic_iterator<const typename jagged<T>::filtered,
+                                            typename jagged<T>::const_row>
+jagged<T>::filtered::begin() const {
+	return basic_iterator<const filtered, const_row>(this, 0);
+}
+
+template <typename T>
+typename jagged<T>::template basic_iterator<const typename jagged<T>::filtered,
+                                            typename jagged<T>::const_row>
+jagged<T>::filtered::end() const {
+	return basic_iterator<const filtered, const_row>(this, size());
+}
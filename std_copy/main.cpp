@@ -1,6 +1,17 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+
+#include "flatten.hpp"
+#include "jagged.hpp"
+
+static_assert(std::random_access_iterator<jagged<int>::iterator>);
+static_assert(std::random_access_iterator<jagged<int>::const_iterator>);
+static_assert(std::ranges::random_access_range<jagged<int>>);
+static_assert(std::ranges::random_access_range<jagged<int>::filtered>);
 
 std::ostream& operator<<(std::ostream& out, const std::vector<int>& input) {
     for(const auto i: input) {
@@ -35,4 +46,83 @@ int main()
         n.insert(n.end(), vec.begin(), vec.end());
     }
     std::cout << "n: {" << n << "}" << std::endl;
+
+    // Same with a jagged array: two allocations, no copy to filter or flatten.
+    jagged<int> j(v);
+    auto f = j.filter([](std::span<const int> it) { return it.size() > 1; });
+    std::cout << "j.filter: ";
+    for(const auto inner: f)
+        std::cout << "{" << std::vector<int>(inner.begin(), inner.end()) << "} ";
+    std::cout << std::endl;
+    auto flat = j.flatten();
+    std::cout << "j.flatten: {" << std::vector<int>(flat.begin(), flat.end()) << "}"
+              << std::endl;
+
+    if(!std::equal(flat.begin(), flat.end(), n.begin(), n.end()))
+        throw std::runtime_error("jagged flatten mismatch");
+    if(f.size() != d.size())
+        throw std::runtime_error("jagged filter mismatch");
+    for(std::size_t i = 0; i < d.size(); ++i) {
+        if(!std::equal(f[i].begin(), f[i].end(), d[i].begin(), d[i].end()))
+            throw std::runtime_error("jagged filter mismatch");
+    }
+    for(std::size_t i = 0; i < v.size(); ++i) {
+        if(!std::equal(j[i].begin(), j[i].end(), v[i].begin(), v[i].end()) ||
+           j[i].data() != flat.data() + j.offsets()[i])
+            throw std::runtime_error("jagged rows mismatch");
+    }
+
+    // Two pass (exact size) parallel flatten and compaction.
+    std::vector<int> p(flatten_size(v.begin(), v.end()));
+    if(flatten(v.begin(), v.end(), p.begin()) != p.end() || p != n)
+        throw std::runtime_error("flatten mismatch");
+    auto c = copy_if_compact(
+        v.begin(),
+        v.end(),
+        [](const std::vector<int>& it) -> bool { return it.size() > 1;});
+    if(c.size() != d.size())
+        throw std::runtime_error("copy_if_compact mismatch");
+    for(std::size_t i = 0; i < d.size(); ++i) {
+        if(!std::equal(c[i].begin(), c[i].end(), d[i].begin(), d[i].end()))
+            throw std::runtime_error("copy_if_compact mismatch");
+    }
+
+    // Same on many rows (several threads, rows split between them).
+    std::vector<std::vector<int>> big(50000);
+    for(std::size_t i = 0; i < big.size(); ++i)
+        big[i].assign(i % 7 == 0 ? 1000 : i % 3, static_cast<int>(i));
+    std::vector<int> ref;
+    for(const auto& vec: big)
+        ref.insert(ref.end(), vec.begin(), vec.end());
+    std::vector<int> res(ref.size());
+    flatten(big.begin(), big.end(), res.begin(), 4);
+    if(res != ref)
+        throw std::runtime_error("parallel flatten mismatch");
+    auto odd = [](const std::vector<int>& it) -> bool {
+        return !it.empty() && it[0] % 2;
+    };
+    auto compact = copy_if_compact(big.begin(), big.end(), odd, 4);
+    ref.clear();
+    for(const auto& vec: big) {
+        if(odd(vec))
+            ref.insert(ref.end(), vec.begin(), vec.end());
+    }
+    auto flat2 = compact.flatten();
+    if(!std::equal(flat2.begin(), flat2.end(), ref.begin(), ref.end()))
+        throw std::runtime_error("parallel copy_if_compact mismatch");
+
+    // A throwing predicate (here in the last slice, i.e. a worker thread) is
+    // rethrown to the caller once every thread is joined.
+    bool thrown = false;
+    try {
+        copy_if_compact(big.begin(), big.end(), [&](const std::vector<int>& it) {
+            if(&it == &big.back())
+                throw std::invalid_argument("predicate");
+            return odd(it);
+        }, 4);
+    } catch(const std::invalid_argument&) {
+        thrown = true;
+    }
+    if(!thrown)
+        throw std::runtime_error("parallel copy_if_compact exception lost");
 }
@@ -0,0 +1,91 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include "two_phase.hpp"
+#include "measure.hpp"
+
+// Cost of foo() calls on a homogeneous collection of Derived objects:
+// virtual call through std::shared_ptr<Base>, CRTP (StaticBase) and
+// std::visit on a std::variant of the two classes.
+// usage: DispatchBench [calls] [objects]
+
+namespace dynamic {
+class Base {
+	public:
+	virtual ~Base() = default;
+	virtual void foo(long i) { value -= i; }
+	long value = 0;
+};
+
+class Derived : public Base {
+	public:
+	void foo(long i) override { value += i; }
+};
+} // namespace dynamic
+
+namespace crtp {
+class Derived : public StaticBase<Derived> {
+	public:
+	void doFoo(long i) { value += i; }
+	long value = 0;
+};
+
+class Other : public StaticBase<Other> {
+	public:
+	void doFoo(long i) { value -= i; }
+	long value = 0;
+};
+} // namespace crtp
+
+using bench::measure;
+
+template <typename Container, typename Call, typename Value>
+void
+run(const char* name, Container& objects, long calls, Call&& call, Value&& value) {
+	const long size   = static_cast<long>(objects.size());
+	const long rounds = calls / size;
+	double elapsed    = measure([&] {
+		for (long r = 0; r < rounds; ++r) {
+			for (auto& object : objects)
+				call(object, r);
+		}
+	});
+	long sum = 0;
+	for (auto& object : objects)
+		sum += value(object);
+	const bool valid = sum == size * (rounds * (rounds - 1) / 2);
+	std::cout << name << ": " << elapsed / static_cast<double>(rounds * size)
+	          << " ns per call" << (valid ? "" : " (wrong result)") << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+	const long calls   = argc > 1 ? std::atol(argv[1]) : 10000000;
+	const long objects = argc > 2 ? std::atol(argv[2]) : 1000;
+
+	std::vector<std::shared_ptr<dynamic::Base>> virtuals;
+	std::vector<crtp::Derived> statics(objects);
+	std::vector<std::variant<crtp::Derived, crtp::Other>> variants(objects);
+	for (long i = 0; i < objects; ++i)
+		virtuals.push_back(std::make_shared<dynamic::Derived>());
+
+	using Variant = std::variant<crtp::Derived, crtp::Other>;
+	run("virtual",
+	    virtuals,
+	    calls,
+	    [](std::shared_ptr<dynamic::Base>& p, long i) { p->foo(i); },
+	    [](std::shared_ptr<dynamic::Base>& p) { return p->value; });
+	run("crtp   ",
+	    statics,
+	    calls,
+	    [](crtp::Derived& d, long i) { d.foo(i); },
+	    [](crtp::Derived& d) { return d.value; });
+	run("variant",
+	    variants,
+	    calls,
+	    [](Variant& v, long i) { std::visit([i](auto& d) { d.foo(i); }, v); },
+	    [](Variant& v) { return std::visit([](auto& d) { return d.value; }, v); });
+}
@@ -1,5 +1,9 @@
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "two_phase.hpp"
 
 // Show that virtual method are not overloaded in constructor
 
@@ -31,6 +35,48 @@ class Derived : public Base {
 	void init() override { std::cout << "Derived::init() called\n"; }
 };
 
+// Two phase: the constructors do not call init(), make_initialized does.
+class InitBase {
+	public:
+	virtual ~InitBase() = default;
+	virtual void foo() { std::cout << "InitBase::foo() called\n"; }
+	std::string initialized;
+
+	protected:
+	friend struct InitAccess;
+	virtual void init() {
+		std::cout << "InitBase::init() called\n";
+		initialized = "InitBase";
+	}
+};
+
+class InitDerived : public InitBase {
+	public:
+	void foo() override { std::cout << "InitDerived::foo() called\n"; }
+
+	protected:
+	friend struct InitAccess;
+	void init() override {
+		InitBase::init();
+		std::cout << "InitDerived::init() called\n";
+		initialized += "+InitDerived";
+	}
+};
+
+// Same with static dispatch (no virtual at all).
+class StaticDerived : public StaticBase<StaticDerived> {
+	public:
+	std::string initialized;
+
+	private:
+	friend class StaticBase<StaticDerived>;
+	void doFoo() { std::cout << "StaticDerived::foo() called\n"; }
+	void doInit() {
+		std::cout << "StaticDerived::init() called\n";
+		initialized = "StaticDerived";
+	}
+};
+
 int
 main() {
 	std::shared_ptr<Base> basePtr =
@@ -41,4 +87,14 @@ main() {
 
 	basePtr->bar();                                     // call Base method .
 	std::dynamic_pointer_cast<Derived>(basePtr)->bar(); // call Derived method
+
+	std::shared_ptr<InitBase> initPtr = make_initialized<InitDerived>();
+	initPtr->foo();
+	if (initPtr->initialized != "InitBase+InitDerived")
+		throw std::runtime_error("two phase init mismatch");
+
+	auto staticPtr = make_initialized<StaticDerived>();
+	staticPtr->foo();
+	if (staticPtr->initialized != "StaticDerived")
+		throw std::runtime_error("static two phase init mismatch");
 }
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+// Two phase construction: a virtual init() called from a constructor is the
+// one of the class being constructed (Base::init() from Base::Base()), so the
+// most derived init() has to be called once the construction is over.
+
+//! @struct InitAccess Give make_initialized access to a protected init():
+//! declare `friend struct InitAccess;` in each class defining init().
+struct InitAccess {
+	template <typename T>
+	static void init(T& object) {
+		object.init();
+	}
+};
+
+//! @brief std::make_shared (one allocation) then the init() of T: the most
+//! derived override when init() is virtual, T::init() when it is static
+//! (CRTP). If init() throws the object is destroyed and the exception
+//! propagated.
+template <typename T, typename... Args>
+std::shared_ptr<T>
+make_initialized(Args&&... args) {
+	std::shared_ptr<T> res = std::make_shared<T>(std::forward<Args>(args)...);
+	InitAccess::init(*res);
+	return res;
+}
+
+//! @class StaticBase CRTP base: foo() and init() dispatch to Impl at compile
+//! time (inlined, no vtable), with a default for each. Impl declares
+//! `friend class StaticBase<Impl>;` if its doFoo()/doInit() are not public.
+template <typename Impl>
+class StaticBase {
+	public:
+	template <typename... Args>
+	void foo(Args&&... args) {
+		impl().doFoo(std::forward<Args>(args)...);
+	}
+
+	protected:
+	friend struct InitAccess;
+	StaticBase() = default;
+	~StaticBase() = default;
+
+	void init() { impl().doInit(); }
+	void doFoo() {}
+	void doInit() {}
+
+	private:
+	Impl& impl() { return static_cast<Impl&>(*this); }
+};
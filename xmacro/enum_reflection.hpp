@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+//! @struct EnumNames Names of the values of an enum declared with an X-macro
+//! list (values must be the default ones, i.e. 0 to N - 1), see ENUM_NAMES.
+template <typename Enum>
+struct EnumNames;
+
+//! @brief Specialize EnumNames for Enum, X must expand to the name string:
+//! @code
+//! #define X(name) #name
+//! ENUM_NAMES(FooBar, FOOBAR_LIST);
+//! #undef X
+//! @endcode
+#define ENUM_NAMES(Enum, LIST)                               \
+	template <>                                              \
+	struct EnumNames<Enum> {                                 \
+		static constexpr std::string_view values[] = {LIST}; \
+	}
+
+namespace details {
+//! @brief FNV-1a hash of s, seeded.
+constexpr std::uint32_t
+hash(std::string_view s, std::uint32_t seed) {
+	std::uint32_t res = 2166136261u ^ seed;
+	for (char c : s)
+		res = (res ^ static_cast<unsigned char>(c)) * 16777619u;
+	return res;
+}
+
+//! @struct PerfectHash Slot (hash(name, seed) & (Size - 1)) of each name.
+//! slots[i] is the index of the name + 1 (0 if empty).
+template <std::size_t Size>
+struct PerfectHash {
+	std::uint32_t seed;
+	std::array<std::uint16_t, Size> slots;
+};
+
+//! @brief Number of slots of the perfect hash of N names (load factor <= 1/2).
+constexpr std::size_t
+hashSize(std::size_t n) {
+	std::size_t res = 1;
+	while (res < 2 * n)
+		res *= 2;
+	return res;
+}
+
+//! @brief Search the first seed without collision of the Enum names.
+template <typename Enum>
+constexpr auto
+makePerfectHash() {
+	constexpr auto& names    = EnumNames<Enum>::values;
+	constexpr std::size_t n  = std::size(names);
+	constexpr std::size_t sz = hashSize(n);
+	PerfectHash<sz> res{};
+	for (res.seed = 0;; ++res.seed) {
+		res.slots  = {};
+		bool valid = true;
+		for (std::size_t i = 0; i < n && valid; ++i) {
+			auto& slot = res.slots[hash(names[i], res.seed) & (sz - 1)];
+			valid      = slot == 0;
+			slot       = static_cast<std::uint16_t>(i + 1);
+		}
+		if (valid) return res;
+	}
+}
+
+template <typename Enum>
+inline constexpr auto kPerfectHash = makePerfectHash<Enum>();
+
+//! @brief True if Enum is an enum with an EnumNames specialization.
+template <typename Enum, typename = void>
+struct HasNames : std::false_type {};
+
+template <typename Enum>
+struct HasNames<Enum, std::void_t<decltype(EnumNames<Enum>::values)>>
+  : std::is_enum<Enum> {};
+
+//! @brief Return type R, only for the enums declared with ENUM_NAMES (so the
+//! unqualified to_string(x) of any other type is not hijacked).
+template <typename Enum, typename R>
+using IfNamed = std::enable_if_t<HasNames<Enum>::value, R>;
+}
+
+//! @brief Name of the value e (e must be a value of the enum).
+template <typename Enum>
+constexpr details::IfNamed<Enum, std::string_view>
+to_string(Enum e) {
+	return EnumNames<Enum>::values[static_cast<std::size_t>(e)];
+}
+
+//! @brief Value of the name s, if any (one hash and one string comparison).
+template <typename Enum>
+constexpr details::IfNamed<Enum, std::optional<Enum>>
+from_string(std::string_view s) {
+	constexpr auto& table = details::kPerfectHash<Enum>;
+	const std::size_t slot =
+	  table.slots[details::hash(s, table.seed) & (table.slots.size() - 1)];
+	if (slot == 0 || EnumNames<Enum>::values[slot - 1] != s) return std::nullopt;
+	return static_cast<Enum>(slot - 1);
+}
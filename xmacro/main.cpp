@@ -1,5 +1,8 @@
 #include <iostream>
-#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "enum_reflection.hpp"
 
 #define FOOBAR_LIST \
  X(FOO), \
@@ -12,10 +15,33 @@ enum class FooBar {
 #undef X
 };
 
+#define X(name) #name //!< @brief XMacro stuff.
+ENUM_NAMES(FooBar, FOOBAR_LIST);
+#undef X
+
+static_assert(to_string(FooBar::BAR) == "BAR");
+static_assert(from_string<FooBar>("INVALID") == FooBar::INVALID);
+static_assert(!from_string<FooBar>("BAZ"));
+
+// Only the enums with names: std::to_string is still picked for other types.
+using std::to_string;
+static_assert(std::is_same_v<decltype(to_string('a')), std::string>);
+static_assert(std::is_same_v<decltype(to_string(FooBar::FOO)), std::string_view>);
+
 std::ostream& operator<<(std::ostream& stream, const FooBar& p);
 
 int
 main() {
+	for (auto name : EnumNames<FooBar>::values) {
+		auto value = from_string<FooBar>(name);
+		if (!value || to_string(*value) != name)
+			throw std::runtime_error("enum round trip mismatch");
+	}
+	for (auto name : {"", "FOO ", "foo", "INVALIDE"}) {
+		if (from_string<FooBar>(name))
+			throw std::runtime_error("enum parsed an unknown name");
+	}
+
 	FooBar foo = FooBar::FOO;
 	std::cout << "foo: " << foo << std::endl;
 	FooBar bar = FooBar::BAR;
@@ -34,12 +60,5 @@ main() {
 
 std::ostream&
 operator<<(std::ostream& stream, const FooBar& value) {
-	static const std::map<FooBar, std::string> fooBarNames = {
-#define X(name) { FooBar::name, #name } //!< @brief XMacro stuff.
-	  FOOBAR_LIST
-#undef X
-	};
-
-	stream << fooBarNames.find(value)->second;
-	return stream;
+	return stream << to_string(value);
 }